@@ -0,0 +1,217 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <fen.hpp>
+#include <search.hpp>
+#include <move_cache.hpp>
+
+namespace {
+	using namespace swo3;
+	using clock = std::chrono::steady_clock;
+
+	constexpr
+	std::array corpus{ //fixed set of positions every benchmark iterates over
+		startpos_fen,
+		std::string_view{"r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3"},    //open game
+		std::string_view{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}, //crowded middlegame
+		std::string_view{"r1b2rk1/pp3ppp/2n1pn2/q1bp4/2P5/P1N1PN2/1PQB1PPP/R3KB1R b KQ - 0 9"},   //queens on board
+		std::string_view{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"},                            //rook endgame
+		std::string_view{"6k1/5ppp/8/8/8/8/5PPP/3Q2K1 w - - 0 1"},                                //back rank mate pending
+		std::string_view{"4k3/8/8/8/8/8/8/4K2R b - - 0 1"},                                       //sparse board
+		std::string_view{"8/8/8/3k4/8/8/8/Q3K3 w - - 0 1"},                                       //tablebase endgame
+	};
+
+	//keeps the optimizer from discarding benchmarked work
+	volatile std::uint64_t sink{0};
+
+	struct result final {
+		std::string name;
+		std::uint64_t ops;        //operations per pass over the corpus
+		std::uint64_t iterations; //passes over the corpus per sample
+		double min_ns, median_ns; //per operation
+	};
+
+	//runs pass repeatedly until min_time elapsed to calibrate, then takes samples of that many iterations
+	auto measure(std::string name, std::uint64_t ops, std::chrono::nanoseconds min_time, int samples, const std::function<std::uint64_t()> & pass) -> result {
+		std::uint64_t iterations{1};
+		for(;;) {
+			const auto start{clock::now()};
+			for(std::uint64_t i{0}; i < iterations; ++i) sink = sink + pass();
+			if(clock::now() - start >= min_time) break;
+			iterations *= 2;
+		}
+
+		std::vector<double> ns;
+		for(auto s{0}; s < samples; ++s) {
+			const auto start{clock::now()};
+			for(std::uint64_t i{0}; i < iterations; ++i) sink = sink + pass();
+			const std::chrono::duration<double, std::nano> elapsed{clock::now() - start};
+			ns.push_back(elapsed.count() / static_cast<double>(iterations * std::max<std::uint64_t>(ops, 1)));
+		}
+		std::ranges::sort(ns);
+		return {std::move(name), ops, iterations, ns.front(), ns[ns.size() / 2]};
+	}
+
+	auto usage() -> int {
+		std::cerr << "usage: chess-bench [--min-time <ms>] [--samples <n>] [--filter <substring>]\n";
+		return 1;
+	}
+}
+
+int main(int argc, char * argv[]) try {
+	std::chrono::milliseconds min_time{200};
+	auto samples{5};
+	std::string_view filter;
+	for(auto i{1}; i < argc; ++i) {
+		const std::string_view arg{argv[i]};
+		if(i + 1 == argc) return usage();
+		if(arg == "--min-time") min_time = std::chrono::milliseconds{std::stoi(argv[++i])};
+		else if(arg == "--samples") samples = std::max(1, std::stoi(argv[++i]));
+		else if(arg == "--filter") filter = argv[++i];
+		else return usage();
+	}
+
+	std::vector<position> positions;
+	for(const auto & fen : corpus) positions.push_back(parse_fen(fen));
+
+	struct located final {
+		const chessboard * board;
+		swo3::pos pos;
+	};
+	std::vector<located> pieces; //every piece in the corpus
+	std::vector<std::pair<const chessboard *, move>> moves; //every legal move in the corpus
+	for(const auto & [board, turn] : positions) {
+		for(auto i{0}; i < 8; ++i)
+			for(auto j{0}; j < 8; ++j)
+				if(board[{i, j}]) pieces.push_back({&board, {i, j}});
+		for(const auto & m : legal_moves(board, turn)) moves.emplace_back(&board, m);
+	}
+
+	std::vector<std::pair<std::string, std::function<result()>>> benchmarks;
+	const auto add{[&](std::string name, std::uint64_t ops, std::function<std::uint64_t()> pass) {
+		benchmarks.emplace_back(name, [=] { return measure(name, ops, min_time, samples, pass); });
+	}};
+
+	add("board_copy", positions.size(), [&, copies{std::vector<chessboard>(positions.size())}]() mutable { //copying into existing storage can't be elided
+		for(std::size_t i{0}; i < positions.size(); ++i) copies[i] = positions[i].board;
+		return static_cast<std::uint64_t>(copies.back()[{7, 4}].has_value());
+	});
+
+	add("test_in_check", 2 * positions.size(), [&] {
+		std::uint64_t n{0};
+		for(const auto & p : positions) n += p.board.test_in_check(color::white) + p.board.test_in_check(color::black);
+		return n;
+	});
+
+	for(const auto glyph : std::string_view{"KQRBNP"}) { //all 64 targets for every piece of that type (both colors)
+		std::vector<located> subset;
+		std::ranges::copy_if(pieces, std::back_inserter(subset), [&](const auto & p) { return std::toupper(static_cast<unsigned char>((*p.board)[p.pos]->glyph())) == glyph; });
+		add(std::string{"is_valid_move/"} + glyph, 64 * subset.size(), [subset] {
+			std::uint64_t n{0};
+			for(const auto & [board, from] : subset)
+				for(auto i{0}; i < 8; ++i)
+					for(auto j{0}; j < 8; ++j)
+						n += static_cast<bool>((*board)[from]->is_valid_move(*board, {from, {i, j}}));
+			return n;
+		});
+	}
+
+	add("generator_creation", pieces.size(), [&] { //creating and destroying the coroutine without resuming it
+		std::uint64_t n{0};
+		for(const auto & [board, from] : pieces) {
+			auto moves{(*board)[from]->valid_moves(*board, from)};
+			n += sizeof(moves);
+		}
+		return n;
+	});
+
+	add("valid_moves", pieces.size(), [&] { //full enumeration per piece
+		std::uint64_t n{0};
+		for(const auto & [board, from] : pieces)
+			for(const auto & m : (*board)[from]->valid_moves(*board, from)) n += m.size() + 1;
+		return n;
+	});
+
+	add("move", moves.size(), [&] { //includes one board_copy per operation
+		std::uint64_t n{0};
+		for(const auto & [board, m] : moves) {
+			auto copy{*board};
+			n += static_cast<std::uint64_t>(copy.move(m));
+		}
+		return n;
+	});
+
+	auto warm{false}; //move_cache holds the valid moves of every piece in the corpus
+	const auto cold_cache{[&] {
+		move_cache::global().budget(64 << 20);
+		move_cache::global().clear();
+		warm = false;
+	}};
+	const auto warm_cache{[&] { //on the first (calibration) pass, therefore excluded from samples
+		if(std::exchange(warm, true)) return;
+		move_cache::global().budget(64 << 20);
+		for(const auto & [board, from] : pieces) move_cache::global().valid_moves(*board, from);
+	}};
+
+	//same operations with an enabled but cold move_cache, i.e. the overhead of misses (cleared before every pass)
+	add("valid_moves/cold", pieces.size(), [&] {
+		cold_cache();
+		std::uint64_t n{0};
+		for(const auto & [board, from] : pieces)
+			for(const auto & m : (*board)[from]->valid_moves(*board, from)) n += m.size() + 1;
+		return n;
+	});
+
+	add("move/cold", moves.size(), [&] {
+		cold_cache();
+		std::uint64_t n{0};
+		for(const auto & [board, m] : moves) {
+			auto copy{*board};
+			n += static_cast<std::uint64_t>(copy.move(m));
+		}
+		return n;
+	});
+
+	//same operations served from a warm move_cache (must stay last as the cache remains enabled)
+	add("valid_moves/cached", pieces.size(), [&] {
+		warm_cache();
+		std::uint64_t n{0};
+		for(const auto & [board, from] : pieces)
+			for(const auto & m : (*board)[from]->valid_moves(*board, from)) n += m.size() + 1;
+		return n;
+	});
+
+	add("move/cached", moves.size(), [&] {
+		warm_cache();
+		std::uint64_t n{0};
+		for(const auto & [board, m] : moves) {
+			auto copy{*board};
+			n += static_cast<std::uint64_t>(copy.move(m));
+		}
+		return n;
+	});
+
+	std::cout << "benchmark,ops,iterations,min_ns_per_op,median_ns_per_op\n";
+	for(const auto & [name, run] : benchmarks)
+		if(name.find(filter) != std::string::npos) {
+			const auto r{run()};
+			std::cout << r.name << ',' << r.ops << ',' << r.iterations << ',' << r.min_ns << ',' << r.median_ns << std::endl;
+		}
+} catch(const std::exception & exc) {
+	std::cerr << "ERR: " << exc.what() << "\n";
+	return 1;
+}
@@ -4,52 +4,41 @@
 //    (See accompanying file ../LICENSE_1_0.txt or copy at
 //          http://www.boost.org/LICENSE_1_0.txt)
 
+#include <limits>
 #include <string>
+#include <charconv>
 #include <iostream>
+#include <string_view>
+#include <server.hpp>
+#include <notation.hpp>
+#include <move_cache.hpp>
 #include <chesspieces.hpp>
+#include "uci.hpp"
 
-auto initial_board() -> swo3::chessboard {
-	swo3::chessboard b;
-
-	b["A8"] = swo3::rook<swo3::color::black>{};
-	b["B8"] = swo3::knight<swo3::color::black>{};
-	b["C8"] = swo3::bishop<swo3::color::black>{};
-	b["D8"] = swo3::queen<swo3::color::black>{};
-	b["E8"] = swo3::king<swo3::color::black>{};
-	b["F8"] = swo3::bishop<swo3::color::black>{};
-	b["G8"] = swo3::knight<swo3::color::black>{};
-	b["H8"] = swo3::rook<swo3::color::black>{};
-	for(auto i{0}; i < 8; ++i) {
-		b[{1, i}] = swo3::pawn<swo3::color::black>{};
-		b[{6, i}] = swo3::pawn<swo3::color::white>{};
+namespace {
+	auto usage() -> int {
+		std::cerr << "usage: chess [--uci | --server [--cache-mb <n>]]\n";
+		return 1;
 	}
-	b["A1"] = swo3::rook<swo3::color::white>{};
-	b["B1"] = swo3::knight<swo3::color::white>{};
-	b["C1"] = swo3::bishop<swo3::color::white>{};
-	b["D1"] = swo3::queen<swo3::color::white>{};
-	b["E1"] = swo3::king<swo3::color::white>{};
-	b["F1"] = swo3::bishop<swo3::color::white>{};
-	b["G1"] = swo3::knight<swo3::color::white>{};
-	b["H1"] = swo3::rook<swo3::color::white>{};
-
-	return b;
 }
 
-int main() {
-	auto b{initial_board()};
+int main(int argc, char * argv[]) try {
+	if(argc >= 2 && argv[1] == std::string_view{"--server"}) {
+		std::size_t cache_mb{0}; //disabled by default, moves rarely revisit positions and the protocol has no query that would profit
+		if(argc == 4 && argv[2] == std::string_view{"--cache-mb"}) {
+			const std::string_view value{argv[3]};
+			if(const auto [ptr, ec]{std::from_chars(value.data(), value.data() + value.size(), cache_mb)}; ec != std::errc{} || ptr != value.data() + value.size() || cache_mb > std::numeric_limits<std::size_t>::max() >> 20) return usage();
+		} else if(argc != 2) return usage();
+		swo3::move_cache::global().budget(cache_mb << 20);
+		return swo3::serve(std::cin, std::cout);
+	}
+	if(argc == 2 && argv[1] == std::string_view{"--uci"}) return swo3::uci(std::cin, std::cout);
+
+	auto b{swo3::initial_board()};
 
-	//TODO: proof of concept parser...
 	std::cout << b << "\nenter move: ";
 	for(std::string input; std::getline(std::cin, input);) try {
-		if(input.size() != 4) throw std::invalid_argument{"unknown move notation"};
-		char from[3], to[3];
-		from[2] = to[2] = 0;
-		from[0] = input[0];
-		from[1] = input[1];
-		to[0] = input[2];
-		to[1] = input[3];
-
-		switch(b.move(swo3::move{from, to})) {
+		switch(b.move(swo3::parse_move(input))) {
 			case swo3::state::checkmate:
 				std::cout << "CHECKMATE!\n";
 				goto end;
@@ -65,4 +54,7 @@ int main() {
 	}
 end:
 	(void)0; //TODO: [C++23] C++23 fixes this language oddity
+} catch(const std::exception & exc) {
+	std::cerr << "ERR: " << exc.what() << "\n";
+	return 1;
 }
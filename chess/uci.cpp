@@ -0,0 +1,160 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <mutex>
+#include <random>
+#include <thread>
+#include <string>
+#include <cstdlib>
+#include <sstream>
+#include <ostream>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <condition_variable>
+#include <fen.hpp>
+#include <search.hpp>
+#include <notation.hpp>
+#include <polyglot.hpp>
+#include "uci.hpp"
+
+namespace swo3 {
+	namespace {
+		auto parse_position(std::istream & tokens) -> position {
+			std::string token;
+			tokens >> token;
+
+			position result;
+			if(token == "startpos") {
+				result = parse_fen(startpos_fen);
+				tokens >> token;
+			} else if(token == "fen") {
+				std::string fen;
+				while(tokens >> token && token != "moves") fen += token + ' ';
+				result = parse_fen(fen);
+			} else throw std::invalid_argument{"unknown position"};
+
+			if(token == "moves")
+				while(tokens >> token) {
+					const auto m{parse_move(token)};
+					if(const auto & piece{std::as_const(result.board)[m.from]}; piece && piece->color() != result.turn) throw std::invalid_argument{"piece at " + to_string(m.from) + " does not belong to the side to move"};
+					result.board.move(m);
+					result.turn = ~result.turn;
+				}
+			return result;
+		}
+
+		auto parse_limits(std::istream & tokens, color turn, bool & infinite) -> search_limits {
+			using namespace std::chrono;
+
+			search_limits result;
+			infinite = false;
+			std::optional<milliseconds> time, increment;
+			auto moves_to_go{30};
+			for(std::string token; tokens >> token;) {
+				auto read{[&] {
+					long long value{0};
+					tokens >> value;
+					return value;
+				}};
+				if(token == "depth") result.depth = static_cast<int>(read());
+				else if(token == "movetime") result.deadline = steady_clock::now() + milliseconds{read()};
+				else if(token == "infinite") infinite = true;
+				else if(token == (turn == color::white ? "wtime" : "btime")) time = milliseconds{read()};
+				else if(token == (turn == color::white ? "winc" : "binc")) increment = milliseconds{read()};
+				else if(token == "movestogo") moves_to_go = std::max(static_cast<int>(read()), 1);
+			}
+			if(time && !infinite) result.deadline = std::min(result.deadline, steady_clock::now() + *time / moves_to_go + increment.value_or(milliseconds{0}) / 2);
+			return result;
+		}
+
+		auto format_info(const chessboard & board, const search_info & info) -> std::string {
+			std::ostringstream os;
+			os << "info depth " << info.depth << " score ";
+			if(std::abs(info.score) >= mate_score - info.depth) os << "mate " << (info.score > 0 ? (mate_score - info.score + 1) / 2 : -(mate_score + info.score) / 2);
+			else os << "cp " << info.score;
+			const auto ms{std::max<std::chrono::milliseconds::rep>(info.time.count(), 1)};
+			os << " nodes " << info.nodes << " nps " << info.nodes * 1000 / static_cast<std::uint64_t>(ms) << " time " << info.time.count() << " pv " << format_move(board, info.best);
+			return os.str();
+		}
+	}
+
+	auto uci(std::istream & in, std::ostream & out) -> int {
+		std::mutex out_mutex;
+		auto send{[&](const std::string & line) {
+			std::scoped_lock lock{out_mutex};
+			out << line << std::endl;
+		}};
+
+		std::optional<position> current{parse_fen(startpos_fen)}; //empty after an invalid "position" until the next valid one
+		std::optional<opening_book> book;
+		std::mt19937_64 gen{std::random_device{}()};
+		std::jthread searcher; //NOTE: must be destroyed before everything it refers to
+		auto stop{[&] {
+			if(!searcher.joinable()) return;
+			searcher.request_stop();
+			searcher.join(); //bestmove has been sent once this returns
+		}};
+
+		for(std::string line; std::getline(in, line);) try {
+			std::istringstream tokens{line};
+			std::string command, token;
+			tokens >> command;
+
+			if(command == "uci") {
+				send("id name TEChess");
+				send("id author Michael Florian Hava");
+				send("option name BookFile type string default <empty>");
+				send("uciok");
+			} else if(command == "isready") send("readyok");
+			else if(command == "ucinewgame") {
+				stop();
+				current = parse_fen(startpos_fen);
+			} else if(command == "position") {
+				stop();
+				current.reset(); //never search a stale position if parsing fails
+				current = parse_position(tokens);
+			} else if(command == "setoption") {
+				std::string name, value;
+				tokens >> token >> name >> token; //"name" <id> "value"
+				std::getline(tokens >> std::ws, value);
+				if(name == "BookFile") {
+					book.reset();
+					if(!value.empty() && value != "<empty>") book.emplace(value);
+				}
+			} else if(command == "go") {
+				stop();
+				if(!current) {
+					send("info string no valid position");
+					send("bestmove 0000");
+					continue;
+				}
+				auto infinite{false};
+				const auto limits{parse_limits(tokens, current->turn, infinite)};
+				if(book && !infinite)
+					if(const auto m{book->pick(current->board, current->turn, gen)}) {
+						send("bestmove " + format_move(current->board, *m));
+						continue;
+					}
+				searcher = std::jthread{[&send, position{*current}, limits, infinite](std::stop_token token) {
+					const auto best{search(position.board, position.turn, limits, token, [&](const search_info & info) { send(format_info(position.board, info)); })};
+					if(infinite) { //bestmove must not be sent before stop
+						std::mutex mutex;
+						std::condition_variable_any cv;
+						std::unique_lock lock{mutex};
+						cv.wait(lock, token, [] { return false; });
+					}
+					send("bestmove " + (best ? format_move(position.board, *best) : std::string{"0000"}));
+				}};
+			} else if(command == "stop") stop();
+			else if(command == "quit") break;
+		} catch(const std::exception & exc) {
+			send(std::string{"info string "} + exc.what());
+		}
+		stop();
+		return 0;
+	}
+}
@@ -0,0 +1,17 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <iosfwd>
+
+namespace swo3 {
+	//Universal Chess Interface, supports "uci", "isready", "ucinewgame", "setoption", "position", "go", "stop" and "quit"
+	// * searching is done on a background thread, therefore all other commands are answered immediately
+	// * "go" supports "depth", "movetime", "wtime"/"btime"/"winc"/"binc"/"movestogo" and "infinite"
+	// * option "BookFile" selects a Polyglot opening book, book moves are played without searching
+	// * after an invalid "position" every "go" is answered with "bestmove 0000" until a valid one is received
+	auto uci(std::istream & in, std::ostream & out) -> int;
+}
@@ -7,11 +7,15 @@
 #pragma once
 #include <span>
 #include <iosfwd>
+#include <string>
+#include <cstdint>
+#include <utility>
 #include <compare>
 #include <concepts>
 #include <optional>
 #include <stdexcept>
 #include "generator.hpp"
+#include "instrumentation.hpp"
 
 namespace swo3 {
 	namespace internal {
@@ -72,7 +76,12 @@ namespace swo3 {
 	};
 
 
-	struct move final { pos from, to; };
+	struct move final {
+		pos from, to;
+
+		friend
+		auto operator==(const move &, const move &) noexcept -> bool =default;
+	};
 
 
 	class move_valid_result final {
@@ -140,9 +149,11 @@ namespace swo3 {
 	class chesspiece final { //runtime "type-erased" wrapper
 		bool moved_{false}; //only mutating state information needed for any chesspiece
 		const struct vtable final { //per-type shared static information (not really a vtable as it turns out that chesspieces are actually stateless...)
-			const color & color;
-			const glyph & glyph;
+			const swo3::color & color;
+			const swo3::glyph & glyph;
 			const bool essential;
+			const bool minor;      //can't force checkmate on its own
+			const bool colorbound; //never leaves squares of its initial color
 			move_valid_result(*is_valid_move)(const chessboard &, move, bool) noexcept;
 			std::optional<chesspiece>(*promotion)(pos) noexcept;
 		} * vptr;
@@ -158,6 +169,8 @@ namespace swo3 {
 				U::color,
 				U::glyph,
 				requires { typename U::essential; },
+				requires { typename U::minor; },
+				requires { typename U::colorbound; },
 				+[](const chessboard & board, move move, [[maybe_unused]] bool moved) noexcept -> move_valid_result {
 					auto result{[&] {
 						if constexpr(internal::valid_move_with_moved_info<U>) return U::is_valid_move(board, move, moved);
@@ -165,10 +178,10 @@ namespace swo3 {
 					}()};
 					return result;
 				},
-				+[]([[maybe_unused]] pos pos) noexcept -> std::optional<chesspiece> {
-					if constexpr(internal::promotable<U>) return U::promotion(pos);
-					else return std::nullopt;
-				}
+				[] {
+					if constexpr(internal::promotable<U>) return +[](pos pos) noexcept -> std::optional<chesspiece> { return U::promotion(pos); };
+					else return nullptr;
+				}()
 			};
 			vptr = &vtable;
 		}
@@ -176,9 +189,16 @@ namespace swo3 {
 		auto moved() const noexcept -> bool { return moved_; }
 		void mark_as_moved() noexcept { moved_ = true; }
 
+		//identifies dynamic type and moved-state, equal for equivalent pieces within the same process
+		auto hash() const noexcept -> std::uint64_t { return reinterpret_cast<std::uintptr_t>(vptr) ^ moved_; }
+		auto same_type(const chesspiece & other) const noexcept -> bool { return vptr == other.vptr; }
+
 		auto color() const noexcept -> color { return vptr->color; }
 		auto glyph() const noexcept -> glyph { return vptr->glyph; }
 		auto essential() const noexcept -> bool { return vptr->essential; }
+		auto minor() const noexcept -> bool { return vptr->minor; }
+		auto colorbound() const noexcept -> bool { return vptr->colorbound; }
+		auto promotable() const noexcept -> bool { return vptr->promotion != nullptr; }
 
 		//central validation:
 		// * nop moves are never valid
@@ -187,26 +207,53 @@ namespace swo3 {
 		auto is_valid_move(const chessboard & board, move move) const noexcept -> move_valid_result;
 		auto valid_moves(chessboard board, pos pos) const -> generator<move_valid_result>;
 
-		void promote(pos pos) noexcept { if(auto tmp{vptr->promotion(pos)}) vptr = tmp->vptr; } //switch "dynamic" type of piece
+		//can this piece capture on move.to according to its own rules? (a pinned piece still gives check)
+		auto attacks(const chessboard & board, move move) const noexcept -> bool;
+
+		void promote(pos pos) noexcept { if(vptr->promotion) if(auto tmp{vptr->promotion(pos)}) vptr = tmp->vptr; } //switch "dynamic" type of piece
 	};
 
 
 	class chessboard final {
+		struct material final { //non-essential pieces of one color
+			int pieces{0};
+			int minors{0};
+			int colorbound[2]{}; //by color of square
+		};
+
 		std::optional<chesspiece> fields[8][8];
-		std::optional<move> last_move_;
+		std::optional<swo3::move> last_move_;
+		material material_[2]; //indexed by color, maintained by move() to detect insufficient material in O(1)
+		bool material_dirty_{false}; //fields were handed out for modification => recount before next move
+		int halfmove_clock_{0}; //plies since last capture or move of a promotable piece
+		[[no_unique_address]] instrumentation::copy_counter copies_;
+
+		auto field(pos pos) noexcept -> std::optional<chesspiece> & { return fields[pos.rank][pos.file]; } //access without invalidating material
+		void count(const chesspiece & piece, pos pos, int delta) noexcept;
 
 		auto test_checkmate(color color) const noexcept -> bool;
 		auto test_stalemate_due_to_no_valid_moves(color color) const noexcept -> bool;
+		auto test_insufficient_material() const noexcept -> bool;
 	public:
 		auto operator[](pos pos) const noexcept -> const std::optional<chesspiece> & { return fields[pos.rank][pos.file]; }
-		auto operator[](pos pos)       noexcept ->       std::optional<chesspiece> & { return fields[pos.rank][pos.file]; }
+		auto operator[](pos pos)       noexcept ->       std::optional<chesspiece> & { material_dirty_ = true; return fields[pos.rank][pos.file]; }
+
+		auto last_move() const noexcept -> const std::optional<swo3::move> & { return last_move_; }
+		void last_move(std::optional<swo3::move> move) noexcept { last_move_ = move; } //e.g. to restore en passant rights of a position
 
-		auto last_move() const noexcept -> const std::optional<move> & { return last_move_; }
+		auto halfmove_clock() const noexcept -> int { return halfmove_clock_; }
+		void halfmove_clock(int plies) noexcept { halfmove_clock_ = plies; }
 
-		auto move(move move) -> state;
+		auto move(swo3::move move) -> state;
+
+		//brings material up to date after the board has been set up field by field, otherwise the next move() does so
+		void recount_material() noexcept;
 
 		auto test_in_check(color color) const noexcept -> bool;
 
+		//Zobrist-style hash of everything that determines valid moves (pieces, their moved-state and the last move)
+		auto hash() const noexcept -> std::uint64_t;
+
 		friend
 		auto operator<<(std::ostream & os, const chessboard & self) -> std::ostream &;
 	};
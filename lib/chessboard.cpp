@@ -5,35 +5,88 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #include <ostream>
-#include "chess.hpp"
+#include "move_cache.hpp"
 
 namespace swo3 {
 	auto chessboard::move(swo3::move move) -> state {
-		auto & self{*this};
-		if(!self[move.from]) throw std::invalid_argument{"no figure at " + to_string(move.from)};
-		const auto result{self[move.from]->is_valid_move(self, move)};
+		instrumentation::timer timer{instrumentation::phase::validate};
+		const auto & piece{field(move.from)};
+		if(!piece) throw std::invalid_argument{"no figure at " + to_string(move.from)};
+		const auto result{[&]() -> move_valid_result {
+			if(auto & cache{move_cache::global()}; cache.enabled()) //a miss is not filled, as validating all destinations costs far more than validating move
+				if(const auto targets{cache.find(*this, move.from)}) {
+					for(const auto & [to, tmp] : *targets)
+						if(to == move.to) return tmp;
+					return false;
+				}
+			return piece->is_valid_move(*this, move);
+		}()};
 		if(!result) throw std::invalid_argument{"move from " + to_string(move.from) + " to " + to_string(move.to) + " is invalid"};
 
+		timer.next(instrumentation::phase::apply);
+		if(material_dirty_) recount_material();
+		auto irreversible{piece->promotable()};
+
 		//actually do the move by means of intermediate moves
 		for(const auto & m : result.value_or(move)) {
-			self[m.to] = std::exchange(self[m.from], {});
-			self[m.to]->mark_as_moved();
+			if(m.from == m.to) continue;
+			if(const auto & captured{field(m.to)}) {
+				count(*captured, m.to, -1);
+				irreversible = true;
+			}
+			count(*field(m.from), m.from, -1);
+			field(m.to) = std::exchange(field(m.from), {});
+			field(m.to)->mark_as_moved();
+			count(*field(m.to), m.to, +1);
 		}
-		self[move.to]->promote(move.to);
+		count(*field(move.to), move.to, -1);
+		field(move.to)->promote(move.to);
+		count(*field(move.to), move.to, +1);
 
 		//record actual input move
 		last_move_ = move;
+		halfmove_clock_ = irreversible ? 0 : halfmove_clock_ + 1;
 
-		if(test_checkmate(~self[move.to]->color())) return state::checkmate;
-		if(test_stalemate_due_to_no_valid_moves(~self[move.to]->color())) return state::stalemate;
+		timer.next(instrumentation::phase::adjudicate);
+		const auto opponent{~field(move.to)->color()};
+		if(test_insufficient_material()) return state::stalemate; //checkmate is impossible => no need to look any further
+		if(test_checkmate(opponent)) return state::checkmate;
+		if(test_stalemate_due_to_no_valid_moves(opponent)) return state::stalemate;
+		if(halfmove_clock_ >= 100) return state::stalemate; //50 moves without captures or moves of promotable pieces
 
-		//TODO: check for stalemate due to not enough material for checkmate
 		//TODO: check for stalemate due to 3 repetitions
-		//TODO: check for stalemate due to 50 moves without captures or pawn moves
 
 		return state::ongoing;
 	}
 
+	void chessboard::count(const chesspiece & piece, pos pos, int delta) noexcept {
+		if(piece.essential()) return;
+		auto & m{material_[static_cast<int>(piece.color())]};
+		m.pieces += delta;
+		if(piece.minor()) m.minors += delta;
+		if(piece.colorbound()) m.colorbound[(pos.rank + pos.file) % 2] += delta;
+	}
+
+	void chessboard::recount_material() noexcept {
+		material_[0] = material_[1] = {};
+		for(auto i{0}; i < 8; ++i)
+			for(auto j{0}; j < 8; ++j)
+				if(const auto & piece{fields[i][j]})
+					count(*piece, {i, j}, +1);
+		material_dirty_ = false;
+	}
+
+	auto chessboard::test_insufficient_material() const noexcept -> bool {
+		const auto & [white, black]{material_};
+		const auto pieces{white.pieces + black.pieces};
+		if(pieces != white.minors + black.minors) return false; //at least one piece that can force checkmate
+		if(pieces <= 1) return true; //lone essentials, possibly with a single minor piece
+
+		//only colorbound minors on squares of the same color can never checkmate
+		const auto first{white.colorbound[0] + black.colorbound[0]}, second{white.colorbound[1] + black.colorbound[1]};
+		return first + second == pieces && (first == 0 || second == 0);
+	}
+
 	auto chessboard::test_checkmate(color color) const noexcept -> bool {
 		if(!test_in_check(color)) return false;
 
@@ -64,12 +117,13 @@ namespace swo3 {
 	}
 
 	auto chessboard::test_in_check(color color) const noexcept -> bool {
+		instrumentation::count(instrumentation::counter::in_check_tests);
 		auto enemy_can_move_here{[&](pos essential) {
 			for(auto i{0}; i < 8; ++i)
 				for(auto j{0}; j < 8; ++j)
 					if(const auto & field{fields[i][j]})
 						if(field->color() != color)
-							if(field->is_valid_move(*this, {{i, j}, essential}))
+							if(field->attacks(*this, {{i, j}, essential}))
 								return true;
 			return false;
 		}};
@@ -83,6 +137,22 @@ namespace swo3 {
 		return false;
 	}
 
+	auto chessboard::hash() const noexcept -> std::uint64_t {
+		const auto mix{[](std::uint64_t x) { //finalizer of splitmix64
+			x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+			x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+			return x ^ (x >> 31);
+		}};
+
+		std::uint64_t result{0};
+		for(auto i{0}; i < 8; ++i)
+			for(auto j{0}; j < 8; ++j)
+				if(const auto & field{fields[i][j]})
+					result ^= mix(field->hash() + 0x9E3779B97F4A7C15 * static_cast<std::uint64_t>(i * 8 + j + 1));
+		if(last_move_) result ^= mix(~static_cast<std::uint64_t>((last_move_->from.rank * 8 + last_move_->from.file) << 6 | (last_move_->to.rank * 8 + last_move_->to.file)));
+		return result;
+	}
+
 	auto operator<<(std::ostream & os, const chessboard & self) -> std::ostream & {
 		os << "   |";
 		for(auto i{0}; i < 8; ++i) os << ' ' << static_cast<char>('a' + i) << ' ';
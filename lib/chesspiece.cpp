@@ -4,7 +4,7 @@
 //    (See accompanying file ../LICENSE_1_0.txt or copy at
 //          http://www.boost.org/LICENSE_1_0.txt)
 
-#include "chess.hpp"
+#include "move_cache.hpp"
 
 namespace swo3 {
 	auto chesspiece::is_valid_move(const chessboard & board, move move) const noexcept -> move_valid_result {
@@ -15,6 +15,7 @@ namespace swo3 {
 			if(piece->color() == vptr->color)
 				return false;
 
+		instrumentation::dispatch(vptr->glyph);
 		auto result{vptr->is_valid_move(board, move, moved_)};
 		if(!result) return false;
 
@@ -27,13 +28,33 @@ namespace swo3 {
 		return result;
 	}
 
+	auto chesspiece::attacks(const chessboard & board, move move) const noexcept -> bool {
+		if(move.from == move.to) return false;
+		instrumentation::dispatch(vptr->glyph);
+		return static_cast<bool>(vptr->is_valid_move(board, move, moved_));
+	}
+
 	auto chesspiece::valid_moves(chessboard board, pos pos) const -> generator<move_valid_result> {
+		auto & cache{move_cache::global()};
+		const auto cacheable{cache.enabled() && board[pos] && board[pos]->hash() == hash()};
+		if(cacheable)
+			if(const auto targets{cache.find(board, pos)}) {
+				for(const auto & [to, result] : *targets)
+					if(result.empty()) co_yield move{pos, to};
+					else co_yield result;
+				co_return;
+			}
+
+		move_cache::targets found; //a miss is only filled if enumerated completely, callers often stop at the first valid move
 		for(int i{0}; i < 8; ++i)
 			for(int j{0}; j < 8; ++j) {
 				const move m{pos, {i, j}};
-				if(auto tmp{is_valid_move(board, m)})
+				if(auto tmp{is_valid_move(board, m)}) {
+					if(cacheable) found.emplace_back(m.to, tmp);
 					if(tmp.empty()) co_yield m;
 					else co_yield tmp;
+				}
 			}
+		if(cacheable) cache.insert(board, pos, std::move(found));
 	}
 }
@@ -12,11 +12,11 @@ namespace swo3 {
 	struct rook final {
 		static
 		constexpr
-		glyph glyph{Color == color::white ? 'R' : 'r'};
+		swo3::glyph glyph{Color == swo3::color::white ? 'R' : 'r'};
 
 		static
 		constexpr
-		color color{Color};
+		swo3::color color{Color};
 
 		static
 		auto is_valid_move(const chessboard & board, move move) noexcept -> bool {
@@ -47,11 +47,11 @@ namespace swo3 {
 
 		static
 		constexpr
-		glyph glyph{Color == color::white ? 'K' : 'k'};
+		swo3::glyph glyph{Color == swo3::color::white ? 'K' : 'k'};
 
 		static
 		constexpr
-		color color{Color};
+		swo3::color color{Color};
 
 		static
 		auto is_valid_move(const chessboard & board, move move, bool moved) noexcept -> move_valid_result { //TODO: logic without hard-coded positions?
@@ -72,7 +72,7 @@ namespace swo3 {
 					static constexpr pos d{Color == color::white ? "D1" : "D8"};
 					static constexpr pos b{Color == color::white ? "B1" : "B8"};
 					if(board[d] || board[c] || board[b]) return false; //can't move through figures for castling
-					return {swo3::move{from, from} /*implicitly validates that king is not in check!*/, swo3::move{from, d}, swo3::move{d, c}, swo3::move{c, b}, swo3::move{a, d}};
+					return {swo3::move{from, from} /*implicitly validates that king is not in check!*/, swo3::move{from, d}, swo3::move{d, c}, swo3::move{a, d}};
 				}
 			}
 
@@ -84,13 +84,16 @@ namespace swo3 {
 
 	template<color Color>
 	struct bishop final {
+		using minor = void;
+		using colorbound = void;
+
 		static
 		constexpr
-		glyph glyph{Color == color::white ? 'B' : 'b'};
+		swo3::glyph glyph{Color == swo3::color::white ? 'B' : 'b'};
 
 		static
 		constexpr
-		color color{Color};
+		swo3::color color{Color};
 
 		static
 		auto is_valid_move(const chessboard & board, move move) noexcept -> bool {
@@ -112,11 +115,11 @@ namespace swo3 {
 	struct queen final {
 		static
 		constexpr
-		glyph glyph{Color == color::white ? 'Q' : 'q'};
+		swo3::glyph glyph{Color == swo3::color::white ? 'Q' : 'q'};
 
 		static
 		constexpr
-		color color{Color};
+		swo3::color color{Color};
 
 		static
 		auto is_valid_move(const chessboard & board, move move) noexcept -> bool { return bishop<Color>::is_valid_move(board, move) || rook<Color>::is_valid_move(board, move); }
@@ -124,13 +127,15 @@ namespace swo3 {
 
 	template<color Color>
 	struct knight final {
+		using minor = void;
+
 		static
 		constexpr
-		glyph glyph{Color == color::white ? 'K' : 'k'};
+		swo3::glyph glyph{Color == swo3::color::white ? 'N' : 'n'};
 
 		static
 		constexpr
-		color color{Color};
+		swo3::color color{Color};
 
 		static
 		auto is_valid_move(const chessboard &, move move) noexcept -> bool {
@@ -146,11 +151,11 @@ namespace swo3 {
 	struct pawn final {
 		static
 		constexpr
-		glyph glyph{Color == color::white ? 'P' : 'p'};
+		swo3::glyph glyph{Color == swo3::color::white ? 'P' : 'p'};
 
 		static
 		constexpr
-		color color{Color};
+		swo3::color color{Color};
 
 		static
 		auto is_valid_move(const chessboard & board, move move, bool moved) noexcept -> move_valid_result {
@@ -187,4 +192,33 @@ namespace swo3 {
 			}
 		}
 	};
+
+	inline
+	auto initial_board() -> chessboard {
+		chessboard b;
+
+		b["A8"] = rook<color::black>{};
+		b["B8"] = knight<color::black>{};
+		b["C8"] = bishop<color::black>{};
+		b["D8"] = queen<color::black>{};
+		b["E8"] = king<color::black>{};
+		b["F8"] = bishop<color::black>{};
+		b["G8"] = knight<color::black>{};
+		b["H8"] = rook<color::black>{};
+		for(auto i{0}; i < 8; ++i) {
+			b[{1, i}] = pawn<color::black>{};
+			b[{6, i}] = pawn<color::white>{};
+		}
+		b["A1"] = rook<color::white>{};
+		b["B1"] = knight<color::white>{};
+		b["C1"] = bishop<color::white>{};
+		b["D1"] = queen<color::white>{};
+		b["E1"] = king<color::white>{};
+		b["F1"] = bishop<color::white>{};
+		b["G1"] = knight<color::white>{};
+		b["H1"] = rook<color::white>{};
+
+		b.recount_material();
+		return b;
+	}
 }
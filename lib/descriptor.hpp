@@ -0,0 +1,140 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <bit>
+#include <array>
+#include <cstdint>
+#include "chess.hpp"
+
+namespace swo3 {
+	struct movement final { //relative to the moving side, positive ranks point towards the opponent
+		int rank, file;
+		int limit{1};        //maximum number of repeated steps: 1 for leapers (jump), 7 for unlimited riders (blocked by pieces in between)
+		bool quiet{true};    //may move to an empty field
+		bool capture{true};  //may capture
+		bool initial{false}; //only allowed if the piece has not moved yet
+	};
+
+
+	template<std::size_t N>
+	struct descriptor final { //declarative description of a piece, usable as template argument
+		movement movements[N];
+		bool essential{false}; //see chesspiece::essential
+		bool minor{false};     //can't force checkmate on its own
+	};
+
+	//the 8 (or 4) symmetric variations of a leap, e.g. leaper(1, 2) for knights
+	constexpr
+	auto leaper(int rank, int file) noexcept -> descriptor<8> {
+		return {{{rank, file}, {rank, -file}, {-rank, file}, {-rank, -file}, {file, rank}, {file, -rank}, {-file, rank}, {-file, -rank}}};
+	}
+
+	//the 8 (or 4) symmetric variations of a slide, e.g. rider(0, 1) for rooks
+	constexpr
+	auto rider(int rank, int file, int limit = 7) noexcept -> descriptor<8> {
+		auto result{leaper(rank, file)};
+		for(auto & m : result.movements) m.limit = limit;
+		return result;
+	}
+
+	//union of all movements, e.g. rider(1, 1) | leaper(1, 2) for an archbishop
+	template<std::size_t N, std::size_t M>
+	constexpr
+	auto operator|(const descriptor<N> & lhs, const descriptor<M> & rhs) noexcept -> descriptor<N + M> {
+		descriptor<N + M> result{{}, lhs.essential || rhs.essential, lhs.minor && rhs.minor};
+		for(std::size_t i{0}; i < N; ++i) result.movements[i] = lhs.movements[i];
+		for(std::size_t i{0}; i < M; ++i) result.movements[N + i] = rhs.movements[i];
+		return result;
+	}
+
+
+	namespace internal {
+		template<bool> struct essential_tag {};
+		template<> struct essential_tag<true> { using essential = void; };
+
+		template<bool> struct minor_tag {};
+		template<> struct minor_tag<true> { using minor = void; };
+
+		template<bool> struct colorbound_tag {};
+		template<> struct colorbound_tag<true> { using colorbound = void; };
+
+		template<auto Descriptor>
+		constexpr
+		bool colorbound{[] {
+			for(const auto & m : Descriptor.movements)
+				if((m.rank + m.file) % 2) return false;
+			return true;
+		}()};
+	}
+
+
+	//chesspiece generated from a descriptor, validation is a lookup in a per-square table built at compile time
+	// * only pieces with movements between from and to (ignoring blockers) are dispatched to the path check
+	// * special rules like castling, en passant or promotion still need a hand-written piece
+	template<color Color, glyph Glyph, auto Descriptor>
+	struct described final : internal::essential_tag<Descriptor.essential>, internal::minor_tag<Descriptor.minor>, internal::colorbound_tag<internal::colorbound<Descriptor>> {
+		static
+		constexpr
+		swo3::glyph glyph{Glyph};
+
+		static
+		constexpr
+		swo3::color color{Color};
+
+		//squares reachable from pos on an empty board
+		static
+		constexpr
+		auto targets(pos pos) noexcept -> std::uint64_t {
+			std::uint64_t result{0};
+			for(auto i{0}; i < 64; ++i)
+				if(table[pos.rank * 8 + pos.file][i]) result |= std::uint64_t{1} << i;
+			return result;
+		}
+
+		static
+		auto is_valid_move(const chessboard & board, move move, bool moved) noexcept -> bool {
+			const auto & to{move.to};
+			const auto & from{move.from};
+			const auto target{static_cast<bool>(board[to])};
+			for(auto candidates{table[from.rank * 8 + from.file][to.rank * 8 + to.file]}; candidates; candidates &= candidates - 1) {
+				const auto & m{Descriptor.movements[std::countr_zero(candidates)]};
+				if((m.initial && moved) || !(target ? m.capture : m.quiet)) continue;
+
+				const auto drank{orientation * m.rank}, dfile{m.file};
+				const auto steps{drank ? (to.rank - from.rank) / drank : (to.file - from.file) / dfile};
+				auto blocked{false};
+				for(auto i{1}; i < steps && !blocked; ++i) blocked = static_cast<bool>(board[{from.rank + i * drank, from.file + i * dfile}]);
+				if(!blocked) return true;
+			}
+			return false;
+		}
+	private:
+		static_assert(std::size(Descriptor.movements) <= 32, "at most 32 movements are supported");
+
+		static
+		constexpr
+		int orientation{Color == swo3::color::white ? -1 : +1}; //rank 0 is black's back rank
+
+		//bitmask of movements per pair of squares that can reach the latter from the former on an empty board
+		static
+		constexpr
+		std::array<std::array<std::uint32_t, 64>, 64> table{[] {
+			std::array<std::array<std::uint32_t, 64>, 64> result{};
+			for(auto from{0}; from < 64; ++from)
+				for(std::size_t i{0}; i < std::size(Descriptor.movements); ++i) {
+					const auto & m{Descriptor.movements[i]};
+					if(m.rank == 0 && m.file == 0) continue;
+					for(auto step{1}; step <= m.limit; ++step) {
+						const auto rank{from / 8 + step * orientation * m.rank}, file{from % 8 + step * m.file};
+						if(rank < 0 || rank > 7 || file < 0 || file > 7) break;
+						result[static_cast<std::size_t>(from)][static_cast<std::size_t>(rank * 8 + file)] |= std::uint32_t{1} << i;
+					}
+				}
+			return result;
+		}()};
+	};
+}
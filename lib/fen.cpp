@@ -0,0 +1,106 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <utility>
+#include <charconv>
+#include "fen.hpp"
+#include "chesspieces.hpp"
+
+namespace swo3 {
+	namespace {
+		auto next_field(std::string_view & fen) noexcept -> std::string_view {
+			const auto begin{fen.find_first_not_of(' ')};
+			if(begin == std::string_view::npos) return {};
+			fen.remove_prefix(begin);
+			const auto field{fen.substr(0, fen.find(' '))};
+			fen.remove_prefix(field.size());
+			return field;
+		}
+	}
+
+	auto parse_piece(char c) -> chesspiece {
+		switch(c) {
+			case 'K': return king<color::white>{};
+			case 'Q': return queen<color::white>{};
+			case 'R': return rook<color::white>{};
+			case 'B': return bishop<color::white>{};
+			case 'N': return knight<color::white>{};
+			case 'P': return pawn<color::white>{};
+			case 'k': return king<color::black>{};
+			case 'q': return queen<color::black>{};
+			case 'r': return rook<color::black>{};
+			case 'b': return bishop<color::black>{};
+			case 'n': return knight<color::black>{};
+			case 'p': return pawn<color::black>{};
+			default: throw std::invalid_argument{"unknown piece"};
+		}
+	}
+
+	auto parse_fen(std::string_view fen) -> position {
+		position result{{}, color::white};
+		auto & board{result.board};
+
+		int rank{0}, file{0};
+		for(const auto c : next_field(fen)) {
+			if(c == '/') {
+				if(file != 8 || ++rank > 7) throw std::invalid_argument{"invalid FEN: malformed rank"};
+				file = 0;
+			} else if(c >= '1' && c <= '8') {
+				if((file += c - '0') > 8) throw std::invalid_argument{"invalid FEN: malformed rank"};
+			} else {
+				if(file > 7) throw std::invalid_argument{"invalid FEN: malformed rank"};
+				board[{rank, file++}] = parse_piece(c);
+			}
+		}
+		if(rank != 7 || file != 8) throw std::invalid_argument{"invalid FEN: malformed board"};
+
+		if(const auto turn{next_field(fen)}; turn == "w") result.turn = color::white;
+		else if(turn == "b") result.turn = color::black;
+		else throw std::invalid_argument{"invalid FEN: unknown side to move"};
+
+		//pawns off their initial rank and kings and rooks without castling rights are considered moved
+		const auto castling{next_field(fen)};
+		const auto may_castle{[&](char right) { return castling.find(right) != std::string_view::npos; }};
+		for(auto i{0}; i < 8; ++i)
+			for(auto j{0}; j < 8; ++j)
+				if(auto & field{board[{i, j}]}) {
+					const pos p{i, j};
+					const auto white{field->color() == color::white};
+					const auto unmoved{[&] {
+						switch(field->glyph()) {
+							case 'P': return i == 6;
+							case 'p': return i == 1;
+							case 'K': return p == pos{"E1"} && (may_castle('K') || may_castle('Q'));
+							case 'k': return p == pos{"E8"} && (may_castle('k') || may_castle('q'));
+							case 'R':
+							case 'r': return (p == (white ? pos{"H1"} : pos{"H8"}) && may_castle(white ? 'K' : 'k')) || (p == (white ? pos{"A1"} : pos{"A8"}) && may_castle(white ? 'Q' : 'q'));
+							default: return true; //moved-state is irrelevant for all other pieces
+						}
+					}()};
+					if(!unmoved) field->mark_as_moved();
+				}
+
+		//en passant target square is mapped to the two-square pawn push that created it
+		if(const auto target{next_field(fen)}; !target.empty() && target != "-") {
+			if(target.size() != 2 || target[1] != (result.turn == color::white ? '6' : '3')) throw std::invalid_argument{"invalid FEN: malformed en passant target square"};
+			const char str[]{target[0], target[1], '\0'};
+			const pos passed{str};
+			const auto step{result.turn == color::white ? 1 : -1}; //direction the opponent's pawn moved in
+			const swo3::move push{{passed.rank - step, passed.file}, {passed.rank + step, passed.file}};
+			const auto & pawn{std::as_const(board)[push.to]};
+			if(!pawn || pawn->glyph() != (result.turn == color::white ? 'p' : 'P') || std::as_const(board)[push.from]) throw std::invalid_argument{"invalid FEN: en passant target square without pushed pawn"};
+			board.last_move(push);
+		}
+		if(const auto clock{next_field(fen)}; !clock.empty()) {
+			int plies{0};
+			if(const auto [ptr, ec]{std::from_chars(clock.data(), clock.data() + clock.size(), plies)}; ec != std::errc{} || ptr != clock.data() + clock.size() || plies < 0) throw std::invalid_argument{"invalid FEN: malformed halfmove clock"};
+			board.halfmove_clock(plies);
+		}
+		//fullmove number is ignored
+		board.recount_material();
+		return result;
+	}
+}
@@ -0,0 +1,27 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <string_view>
+#include "chess.hpp"
+
+namespace swo3 {
+	struct position final {
+		chessboard board;
+		color turn;
+	};
+
+
+	inline
+	constexpr
+	std::string_view startpos_fen{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
+
+	//standard pieces by their glyph, throws std::invalid_argument for unknown glyphs
+	auto parse_piece(char glyph) -> chesspiece;
+
+	//only supports standard pieces, castling rights are mapped to the moved-state of kings and rooks and the en passant target square to the last move
+	auto parse_fen(std::string_view fen) -> position;
+}
@@ -6,8 +6,10 @@
 
 #pragma once
 #include <ranges>
+#include <utility>
 #include <coroutine>
 #include <type_traits>
+#include "instrumentation.hpp"
 
 namespace swo3 {
 	template<typename Reference>
@@ -32,6 +34,8 @@ namespace swo3 {
 
 			std::add_pointer_t<yielded> ptr{nullptr};
 		public:
+			promise_type() noexcept { instrumentation::count(instrumentation::counter::generator_frames); }
+
 			auto get_return_object() noexcept -> generator { return std::coroutine_handle<promise_type>::from_promise(*this); }
 
 			auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
@@ -0,0 +1,205 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <iomanip>
+#include <ostream>
+#include <algorithm>
+#include "instrumentation.hpp"
+
+namespace swo3::instrumentation {
+	namespace {
+		using clock = std::chrono::steady_clock;
+
+		constexpr
+		std::size_t max_events{1'000'000};
+
+		constexpr
+		const char * phase_names[]{"validate", "apply", "adjudicate"};
+
+		struct event final {
+			phase what;
+			clock::time_point begin, end;
+		};
+
+		struct block final { //counters of a single thread, only written by that thread
+			std::array<std::atomic<std::uint64_t>, 256> dispatches{};
+			std::array<std::atomic<std::uint64_t>, 3> counters{};   //indexed by counter
+			std::array<std::atomic<std::uint64_t>, 3> phase_calls{}; //indexed by phase
+			std::array<std::atomic<std::uint64_t>, 3> phase_ns{};    //indexed by phase
+			int tid;
+
+			std::mutex mutex; //guards events
+			std::vector<event> events;
+
+			explicit
+			block(int tid) noexcept : tid{tid} {}
+
+			void add_to(stats & result) const noexcept {
+				const auto load{[](const auto & value) { return value.load(std::memory_order_relaxed); }};
+				for(std::size_t i{0}; i < dispatches.size(); ++i) result.dispatches[i] += load(dispatches[i]);
+				result.board_copies     += load(counters[static_cast<int>(counter::board_copies)]);
+				result.in_check_tests   += load(counters[static_cast<int>(counter::in_check_tests)]);
+				result.generator_frames += load(counters[static_cast<int>(counter::generator_frames)]);
+				for(std::size_t i{0}; i < result.move_phases.size(); ++i) {
+					result.move_phases[i].calls += load(phase_calls[i]);
+					result.move_phases[i].time  += std::chrono::nanoseconds{load(phase_ns[i])};
+				}
+			}
+
+			void reset() noexcept {
+				const auto clear{[](auto & values) { for(auto & value : values) value.store(0, std::memory_order_relaxed); }};
+				clear(dispatches);
+				clear(counters);
+				clear(phase_calls);
+				clear(phase_ns);
+			}
+		};
+
+		struct retired_event final {
+			event what;
+			int tid;
+		};
+
+		struct registry final {
+			std::mutex mutex;
+			std::vector<block *> live;
+			stats retired;                             //totals of finished threads
+			std::vector<retired_event> retired_events; //of finished threads
+			int next_tid{1};
+			const clock::time_point epoch{clock::now()};
+			std::atomic<bool> tracing{false};
+		};
+
+		auto global() noexcept -> registry & {
+			static registry instance;
+			return instance;
+		}
+
+		class registration final { //registers the block of the current thread and merges it into the totals upon thread exit
+			std::unique_ptr<block> ptr;
+		public:
+			registration() {
+				auto & reg{global()};
+				std::scoped_lock lock{reg.mutex};
+				ptr = std::make_unique<block>(reg.next_tid++);
+				reg.live.push_back(ptr.get());
+			}
+			registration(const registration &) =delete;
+			auto operator=(const registration &) -> registration & =delete;
+			~registration() noexcept {
+				auto & reg{global()};
+				std::scoped_lock lock{reg.mutex, ptr->mutex};
+				std::erase(reg.live, ptr.get());
+				ptr->add_to(reg.retired);
+				for(const auto & e : ptr->events) reg.retired_events.push_back({e, ptr->tid});
+			}
+
+			auto get() const noexcept -> block & { return *ptr; }
+		};
+
+		auto local() noexcept -> block & {
+			thread_local registration instance;
+			return instance.get();
+		}
+
+		void increment(std::atomic<std::uint64_t> & value, std::uint64_t delta = 1) noexcept { value.fetch_add(delta, std::memory_order_relaxed); }
+	}
+
+	namespace internal {
+		void count(counter counter) noexcept { increment(local().counters[static_cast<int>(counter)]); }
+
+		void dispatch(char glyph) noexcept { increment(local().dispatches[static_cast<unsigned char>(glyph)]); }
+
+		void record(phase phase, clock::time_point begin, clock::time_point end) noexcept {
+			auto & self{local()};
+			const auto i{static_cast<int>(phase)};
+			increment(self.phase_calls[i]);
+			increment(self.phase_ns[i], static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+			if(global().tracing.load(std::memory_order_relaxed)) {
+				std::scoped_lock lock{self.mutex};
+				if(self.events.size() < max_events) try {
+					self.events.push_back({phase, begin, end});
+				} catch(...) {} //tracing is best effort
+			}
+		}
+	}
+
+	auto operator<<(std::ostream & os, const stats & self) -> std::ostream & {
+		auto first{true};
+		const auto print{[&](const auto & key, auto value) {
+			if(!value) return;
+			os << (first ? "" : " ") << key << '=' << value;
+			first = false;
+		}};
+		for(std::size_t i{0}; i < self.dispatches.size(); ++i)
+			if(self.dispatches[i]) {
+				os << (first ? "" : " ") << "dispatch." << static_cast<char>(i) << '=' << self.dispatches[i];
+				first = false;
+			}
+		print("board_copies", self.board_copies);
+		print("in_check_tests", self.in_check_tests);
+		print("generator_frames", self.generator_frames);
+		for(std::size_t i{0}; i < self.move_phases.size(); ++i) {
+			print(std::string{"move."} + phase_names[i] + ".calls", self.move_phases[i].calls);
+			print(std::string{"move."} + phase_names[i] + ".ns", self.move_phases[i].time.count());
+		}
+		return os;
+	}
+
+	auto snapshot() -> stats {
+		auto & reg{global()};
+		std::scoped_lock lock{reg.mutex};
+		auto result{reg.retired};
+		for(const auto b : reg.live) b->add_to(result);
+		return result;
+	}
+
+	void reset() noexcept {
+		auto & reg{global()};
+		std::scoped_lock lock{reg.mutex};
+		reg.retired = {};
+		for(const auto b : reg.live) b->reset();
+	}
+
+	void start_tracing() noexcept { global().tracing = true; }
+
+	void stop_tracing() noexcept { global().tracing = false; }
+
+	void write_trace(std::ostream & os) {
+		auto & reg{global()};
+		std::vector<retired_event> events;
+		{
+			std::scoped_lock lock{reg.mutex};
+			events = std::exchange(reg.retired_events, {});
+			for(const auto b : reg.live) {
+				std::scoped_lock block_lock{b->mutex};
+				for(const auto & e : b->events) events.push_back({e, b->tid});
+				b->events.clear();
+			}
+		}
+		std::ranges::sort(events, {}, [](const auto & e) { return e.what.begin; });
+
+		const auto micros{[&](clock::duration d) { return std::chrono::duration<double, std::micro>{d}.count(); }};
+		const auto flags{os.flags()};
+		const auto precision{os.precision()};
+		os << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+		for(auto first{true}; const auto & [e, tid] : events) {
+			os << (first ? "\n" : ",\n")
+			   << "{\"name\":\"" << phase_names[static_cast<int>(e.what)] << "\",\"cat\":\"move\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+			   << ",\"ts\":" << micros(e.begin - reg.epoch) << ",\"dur\":" << micros(e.end - e.begin) << '}';
+			first = false;
+		}
+		os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+		os.flags(flags);
+		os.precision(precision);
+	}
+}
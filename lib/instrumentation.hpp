@@ -0,0 +1,105 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <array>
+#include <chrono>
+#include <iosfwd>
+#include <cstdint>
+#include <type_traits>
+
+//opt-in counters and trace events for the hot paths of chess-lib, enabled by configuring with -DCHESS_INSTRUMENTATION=ON
+// * when disabled all hooks compile to nothing and chessboard stays trivially copyable, the query API reports zeros
+// * counters are kept per thread and summed up on demand, therefore hooks never contend with each other
+namespace swo3::instrumentation {
+	inline
+	constexpr
+	bool enabled{
+#ifdef SWO3_INSTRUMENTATION
+		true
+#else
+		false
+#endif
+	};
+
+	enum class counter { board_copies, in_check_tests, generator_frames, };
+	enum class phase { validate, apply, adjudicate, }; //of chessboard::move
+
+
+	struct stats final {
+		struct timing final {
+			std::uint64_t calls{0};
+			std::chrono::nanoseconds time{0};
+		};
+
+		std::array<std::uint64_t, 256> dispatches{}; //type-erased is_valid_move calls by glyph
+		std::uint64_t board_copies{0};
+		std::uint64_t in_check_tests{0};
+		std::uint64_t generator_frames{0};
+		std::array<timing, 3> move_phases{}; //indexed by phase
+	};
+
+	//prints all non-zero values as space separated "key=value" pairs, e.g. "dispatch.K=12 board_copies=3 move.apply.ns=1500"
+	auto operator<<(std::ostream & os, const stats & self) -> std::ostream &;
+
+	auto snapshot() -> stats; //totals of all threads (including finished ones) since the last reset
+	void reset() noexcept;
+
+	//while tracing every move phase is recorded as an event (capped at 1M events per thread)
+	void start_tracing() noexcept;
+	void stop_tracing() noexcept;
+	void write_trace(std::ostream & os); //Chrome trace event format (chrome://tracing, Perfetto), discards written events
+
+
+	namespace internal {
+		void count(counter counter) noexcept;
+		void dispatch(char glyph) noexcept;
+		void record(phase phase, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) noexcept;
+
+		struct counting_copies final {
+			counting_copies() noexcept =default;
+			counting_copies(const counting_copies &) noexcept { count(counter::board_copies); }
+			auto operator=(const counting_copies &) noexcept -> counting_copies & { count(counter::board_copies); return *this; }
+		};
+		struct not_counting_copies final {};
+	}
+
+	inline
+	void count(counter counter) noexcept { if constexpr(enabled) internal::count(counter); }
+
+	inline
+	void dispatch(char glyph) noexcept { if constexpr(enabled) internal::dispatch(glyph); }
+
+	//member of a class to count how often it is copied
+	using copy_counter = std::conditional_t<enabled, internal::counting_copies, internal::not_counting_copies>;
+
+
+	template<bool Enabled = enabled>
+	class [[nodiscard]] basic_timer final { //times consecutive phases, the last one ends upon destruction
+		struct nothing final {};
+		using time_point = std::conditional_t<Enabled, std::chrono::steady_clock::time_point, nothing>;
+
+		phase current;
+		[[no_unique_address]] time_point begin;
+	public:
+		explicit
+		basic_timer(phase phase) noexcept : current{phase} { if constexpr(Enabled) begin = std::chrono::steady_clock::now(); }
+		basic_timer(const basic_timer &) =delete;
+		auto operator=(const basic_timer &) -> basic_timer & =delete;
+		~basic_timer() noexcept { if constexpr(Enabled) internal::record(current, begin, std::chrono::steady_clock::now()); }
+
+		void next(phase phase) noexcept {
+			if constexpr(Enabled) {
+				const auto now{std::chrono::steady_clock::now()};
+				internal::record(current, begin, now);
+				begin = now;
+			}
+			current = phase;
+		}
+	};
+
+	using timer = basic_timer<>;
+}
@@ -0,0 +1,79 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <system_error>
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+namespace swo3 {
+#ifdef _WIN32
+	mapped_file::mapped_file(const std::filesystem::path & path) {
+		const auto fail{[](const char * what, DWORD error = GetLastError()) { throw std::system_error{static_cast<int>(error), std::system_category(), what}; }};
+
+		const auto file{CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+		if(file == INVALID_HANDLE_VALUE) fail("CreateFileW");
+		LARGE_INTEGER size;
+		if(!GetFileSizeEx(file, &size)) {
+			const auto error{GetLastError()};
+			CloseHandle(file);
+			fail("GetFileSizeEx", error);
+		}
+		if(size.QuadPart == 0) { //empty files can't be mapped
+			CloseHandle(file);
+			return;
+		}
+		const auto mapping{CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+		auto error{GetLastError()};
+		CloseHandle(file);
+		if(!mapping) fail("CreateFileMappingW", error);
+		const auto view{MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+		error = GetLastError();
+		CloseHandle(mapping); //view keeps the mapping alive
+		if(!view) fail("MapViewOfFile", error);
+		data_ = static_cast<const std::byte *>(view);
+		size_ = static_cast<std::size_t>(size.QuadPart);
+	}
+
+	mapped_file::~mapped_file() noexcept { if(data_) UnmapViewOfFile(data_); }
+#else
+	mapped_file::mapped_file(const std::filesystem::path & path) {
+		const auto fail{[](const char * what, int error = errno) { throw std::system_error{error, std::generic_category(), what}; }};
+
+		const auto file{::open(path.c_str(), O_RDONLY)};
+		if(file == -1) fail("open");
+		struct stat info;
+		if(::fstat(file, &info) == -1) {
+			const auto error{errno};
+			::close(file);
+			fail("fstat", error);
+		}
+		if(info.st_size == 0) { //empty files can't be mapped
+			::close(file);
+			return;
+		}
+		const auto size{static_cast<std::size_t>(info.st_size)};
+		const auto view{::mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0)};
+		const auto error{errno};
+		::close(file); //mapping stays valid after closing the descriptor
+		if(view == MAP_FAILED) fail("mmap", error);
+		data_ = static_cast<const std::byte *>(view);
+		size_ = size;
+	}
+
+	mapped_file::~mapped_file() noexcept { if(data_) ::munmap(const_cast<std::byte *>(data_), size_); }
+#endif
+}
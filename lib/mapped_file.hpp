@@ -0,0 +1,31 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <span>
+#include <cstddef>
+#include <utility>
+#include <filesystem>
+
+namespace swo3 {
+	class mapped_file final { //read-only memory mapping of a whole file, shared between all processes mapping the same file
+		const std::byte * data_{nullptr};
+		std::size_t size_{0};
+	public:
+		explicit
+		mapped_file(const std::filesystem::path & path); //throws std::system_error
+		mapped_file(const mapped_file &) =delete;
+		mapped_file(mapped_file && other) noexcept : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {}
+		auto operator=(mapped_file other) noexcept -> mapped_file & {
+			std::swap(data_, other.data_);
+			std::swap(size_, other.size_);
+			return *this;
+		}
+		~mapped_file() noexcept;
+
+		auto bytes() const noexcept -> std::span<const std::byte> { return {data_, size_}; }
+	};
+}
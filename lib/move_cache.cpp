@@ -0,0 +1,98 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "move_cache.hpp"
+
+namespace swo3 {
+	auto move_cache::global() noexcept -> move_cache & {
+		static move_cache instance;
+		return instance;
+	}
+
+	void move_cache::budget(std::size_t bytes) {
+		budget_ = bytes;
+		for(auto & s : shards) {
+			std::scoped_lock lock{s.mutex};
+			evict(s, bytes / shard_count);
+		}
+	}
+
+	auto move_cache::find(const chessboard & board, pos from) -> std::shared_ptr<const targets> {
+		const key k{board.hash(), static_cast<std::int8_t>(from.rank * 8 + from.file)};
+		auto & s{shards[key_hash{}(k) % shard_count]};
+		std::scoped_lock lock{s.mutex};
+		if(const auto it{s.index.find(k)}; it != s.index.end()) {
+			s.lru.splice(s.lru.begin(), s.lru, it->second);
+			++hits;
+			return it->second->second;
+		}
+		++misses;
+		return nullptr;
+	}
+
+	auto move_cache::valid_moves(const chessboard & board, pos from) -> std::shared_ptr<const targets> {
+		if(auto cached{find(board, from)}) return cached;
+
+		//computed without holding the lock, concurrent misses of the same key compute redundantly but identically
+		targets result;
+		const auto & piece{*board[from]};
+		for(auto i{0}; i < 8; ++i)
+			for(auto j{0}; j < 8; ++j)
+				if(auto tmp{piece.is_valid_move(board, {from, {i, j}})})
+					result.emplace_back(pos{i, j}, tmp);
+		return insert(board, from, std::move(result));
+	}
+
+	auto move_cache::insert(const chessboard & board, pos from, targets targets) -> std::shared_ptr<const move_cache::targets> {
+		const key k{board.hash(), static_cast<std::int8_t>(from.rank * 8 + from.file)};
+		auto & s{shards[key_hash{}(k) % shard_count]};
+		auto result{std::make_shared<const move_cache::targets>(std::move(targets))};
+		const auto limit{budget() / shard_count};
+		if(const auto size{size_of(*result)}; size <= limit) {
+			std::scoped_lock lock{s.mutex};
+			if(!s.index.contains(k)) {
+				s.lru.emplace_front(k, result);
+				s.index.emplace(k, s.lru.begin());
+				s.bytes += size;
+				evict(s, limit);
+			}
+		}
+		return result;
+	}
+
+	auto move_cache::stats() const -> statistics {
+		statistics result{hits, misses, evictions, 0, 0};
+		for(const auto & s : shards) {
+			std::scoped_lock lock{s.mutex};
+			result.entries += s.index.size();
+			result.bytes += s.bytes;
+		}
+		return result;
+	}
+
+	void move_cache::clear() {
+		for(auto & s : shards) {
+			std::scoped_lock lock{s.mutex};
+			s.lru.clear();
+			s.index.clear();
+			s.bytes = 0;
+		}
+	}
+
+	auto move_cache::size_of(const targets & targets) noexcept -> std::size_t { //approximation of list node, index node and payload
+		return 4 * sizeof(void *) + sizeof(key) + sizeof(std::shared_ptr<const move_cache::targets>) + 2 * sizeof(void *) + sizeof(key) + sizeof(move_cache::targets) + targets.capacity() * sizeof(move_cache::targets::value_type);
+	}
+
+	void move_cache::evict(shard & shard, std::size_t limit) {
+		while(shard.bytes > limit && !shard.lru.empty()) {
+			const auto & [k, value]{shard.lru.back()};
+			shard.bytes -= size_of(*value);
+			shard.index.erase(k);
+			shard.lru.pop_back();
+			++evictions;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <list>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+#include "chess.hpp"
+
+namespace swo3 {
+	class move_cache final { //bounded, thread-safe LRU cache of the valid moves of a piece keyed by chessboard::hash
+	public:
+		using targets = std::vector<std::pair<pos, move_valid_result>>; //all valid destinations with the result of chesspiece::is_valid_move
+
+		struct statistics final {
+			std::uint64_t hits, misses, evictions;
+			std::size_t entries, bytes;
+		};
+
+		//filled by chesspiece::valid_moves and consulted by chessboard::move, disabled until given a budget
+		static
+		auto global() noexcept -> move_cache &;
+
+		explicit
+		move_cache(std::size_t budget = 0) noexcept : budget_{budget} {}
+		move_cache(const move_cache &) =delete;
+		auto operator=(const move_cache &) -> move_cache & =delete;
+
+		auto enabled() const noexcept -> bool { return budget_.load(std::memory_order_relaxed) != 0; }
+		auto budget() const noexcept -> std::size_t { return budget_.load(std::memory_order_relaxed); }
+		void budget(std::size_t bytes); //approximate memory limit, 0 disables and clears the cache
+
+		//valid moves of the piece at from, computed and inserted on a miss (precondition: board[from] holds a piece)
+		auto valid_moves(const chessboard & board, pos from) -> std::shared_ptr<const targets>;
+		//cached valid moves of the piece at from, nullptr on a miss
+		auto find(const chessboard & board, pos from) -> std::shared_ptr<const targets>;
+		//inserts all valid moves of the piece at from, unless already cached or too large for the budget
+		auto insert(const chessboard & board, pos from, targets targets) -> std::shared_ptr<const move_cache::targets>;
+
+		auto stats() const -> statistics;
+		void clear();
+	private:
+		struct key final {
+			std::uint64_t hash;
+			std::int8_t from;
+
+			friend
+			auto operator==(const key &, const key &) -> bool =default;
+		};
+		struct key_hash final {
+			auto operator()(const key & k) const noexcept -> std::size_t { return static_cast<std::size_t>(k.hash ^ (static_cast<std::uint64_t>(k.from) * 0x9E3779B97F4A7C15)); }
+		};
+
+		struct shard final { //independently locked to reduce contention
+			mutable std::mutex mutex;
+			std::list<std::pair<key, std::shared_ptr<const targets>>> lru; //most recently used first
+			std::unordered_map<key, decltype(lru)::iterator, key_hash> index;
+			std::size_t bytes{0};
+		};
+
+		static
+		constexpr
+		std::size_t shard_count{16};
+
+		static
+		auto size_of(const targets & targets) noexcept -> std::size_t;
+		void evict(shard & shard, std::size_t limit);
+
+		std::atomic<std::size_t> budget_;
+		std::array<shard, shard_count> shards;
+		std::atomic<std::uint64_t> hits{0}, misses{0}, evictions{0};
+	};
+}
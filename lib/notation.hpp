@@ -0,0 +1,31 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <string>
+#include <string_view>
+#include "chess.hpp"
+
+namespace swo3 {
+	inline
+	auto parse_move(std::string_view input) -> move { //TODO: proof of concept parser...
+		if(input.size() == 5 && (input[4] == 'q' || input[4] == 'Q')) input.remove_suffix(1); //TODO: pawns are always promoted to queens
+		if(input.size() != 4) throw std::invalid_argument{"unknown move notation"};
+		const char from[]{input[0], input[1], '\0'}, to[]{input[2], input[3], '\0'};
+		return {from, to};
+	}
+
+	inline
+	auto format_move(const chessboard & board, move move) -> std::string { //long algebraic notation as expected by UCI
+		std::string result;
+		for(const auto & p : {move.from, move.to}) {
+			result += static_cast<char>('a' + p.file);
+			result += static_cast<char>('8' - p.rank);
+		}
+		if(const auto & piece{board[move.from]}; piece && (piece->glyph() == 'P' || piece->glyph() == 'p') && (move.to.rank == 0 || move.to.rank == 7)) result += 'q';
+		return result;
+	}
+}
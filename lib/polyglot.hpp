@@ -0,0 +1,46 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include "chess.hpp"
+#include "mapped_file.hpp"
+
+namespace swo3 {
+	//Zobrist hash as used by Polyglot opening books, pieces without a standard counterpart are ignored
+	auto polyglot_hash(const chessboard & board, color turn) noexcept -> std::uint64_t;
+
+
+	class opening_book final { //memory-mapped Polyglot ".bin" book, entries are sorted by hash and looked up by binary search
+		mapped_file file;
+	public:
+		struct entry final {
+			swo3::move move;
+			std::uint16_t weight;
+		};
+
+		explicit
+		opening_book(const std::filesystem::path & path); //throws std::system_error or std::invalid_argument
+
+		//all book moves that are valid on board
+		auto lookup(const chessboard & board, color turn) const -> std::vector<entry>;
+
+		//picks a book move with probability proportional to its weight, moves with weight 0 are never played
+		template<typename URBG>
+		requires std::uniform_random_bit_generator<std::remove_cvref_t<URBG>>
+		auto pick(const chessboard & board, color turn, URBG && gen) const -> std::optional<move> {
+			const auto entries{lookup(board, turn)};
+			if(std::ranges::all_of(entries, [](const auto & e) { return e.weight == 0; })) return std::nullopt;
+			std::vector<double> weights(entries.size());
+			std::ranges::transform(entries, weights.begin(), [](const auto & e) { return static_cast<double>(e.weight); });
+			return entries[std::discrete_distribution<std::size_t>{weights.begin(), weights.end()}(gen)].move;
+		}
+	};
+}
@@ -0,0 +1,115 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include "search.hpp"
+
+namespace swo3 {
+	namespace {
+		constexpr
+		auto value(glyph glyph) noexcept -> int {
+			switch(glyph) {
+				case 'P': case 'p': return 100;
+				case 'N': case 'n': return 320;
+				case 'B': case 'b': return 330;
+				case 'R': case 'r': return 500;
+				case 'Q': case 'q': return 900;
+				default: return 0; //essential or unknown pieces
+			}
+		}
+
+		struct aborted final {}; //unwinds the search once a limit has been reached
+
+		struct context final {
+			search_limits limits;
+			std::stop_token token;
+			std::uint64_t nodes{0};
+
+			void tick() {
+				++nodes;
+				if(token.stop_requested() || std::chrono::steady_clock::now() >= limits.deadline) throw aborted{};
+			}
+		};
+
+		auto negamax(context & ctx, const chessboard & board, color color, int depth, int ply, int alpha, int beta) -> int {
+			ctx.tick();
+			if(depth == 0) return evaluate(board, color);
+
+			for(const auto & m : legal_moves(board, color)) {
+				auto copy{board};
+				int score;
+				switch(copy.move(m)) {
+					case state::checkmate: score = mate_score - ply - 1; break;
+					case state::stalemate: score = 0; break;
+					default: score = -negamax(ctx, copy, ~color, depth - 1, ply + 1, -beta, -alpha);
+				}
+				if(score >= beta) return score;
+				alpha = std::max(alpha, score);
+			}
+			return alpha;
+		}
+	}
+
+	auto legal_moves(const chessboard & board, color color) -> std::vector<move> {
+		std::vector<move> result;
+		for(auto i{0}; i < 8; ++i)
+			for(auto j{0}; j < 8; ++j)
+				if(const auto & field{board[{i, j}]})
+					if(field->color() == color)
+						for(auto k{0}; k < 8; ++k)
+							for(auto l{0}; l < 8; ++l)
+								if(const move m{{i, j}, {k, l}}; field->is_valid_move(board, m))
+									result.push_back(m);
+		return result;
+	}
+
+	auto evaluate(const chessboard & board, color color) noexcept -> int {
+		auto result{0};
+		for(auto i{0}; i < 8; ++i)
+			for(auto j{0}; j < 8; ++j)
+				if(const auto & field{board[{i, j}]})
+					result += field->color() == color ? value(field->glyph()) : -value(field->glyph());
+		return result;
+	}
+
+	auto search(const chessboard & board, color color, search_limits limits, std::stop_token token, const std::function<void(const search_info &)> & report) -> std::optional<move> {
+		auto moves{legal_moves(board, color)};
+		if(moves.empty()) return std::nullopt;
+
+		const auto start{std::chrono::steady_clock::now()};
+		context ctx{limits, token};
+		auto best{moves.front()};
+		try {
+			for(auto depth{1}; depth <= limits.depth; ++depth) {
+				auto alpha{-mate_score};
+				auto current{moves.front()};
+				for(const auto & m : moves) {
+					ctx.tick();
+					auto copy{board};
+					int score;
+					switch(copy.move(m)) {
+						case state::checkmate: score = mate_score - 1; break;
+						case state::stalemate: score = 0; break;
+						default: score = -negamax(ctx, copy, ~color, depth - 1, 1, -mate_score, -alpha);
+					}
+					if(score > alpha) {
+						alpha = score;
+						current = m;
+					}
+				}
+				best = current;
+
+				//search best move first in next iteration
+				const auto it{std::ranges::find(moves, best)};
+				std::rotate(moves.begin(), it, it + 1);
+
+				if(report) report({depth, alpha, ctx.nodes, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start), best});
+				if(alpha >= mate_score - depth) break; //forced mate found, searching deeper can't improve on that
+			}
+		} catch(const aborted &) {}
+		return best;
+	}
+}
@@ -0,0 +1,47 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <limits>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include <stop_token>
+#include "chess.hpp"
+
+namespace swo3 {
+	//all moves color can make, expressed as input moves (e.g. castling is the king moving two fields)
+	auto legal_moves(const chessboard & board, color color) -> std::vector<move>;
+
+	//material balance from the perspective of color, essential pieces don't count
+	auto evaluate(const chessboard & board, color color) noexcept -> int;
+
+
+	inline
+	constexpr
+	int mate_score{100'000}; //mate in n plies is reported as mate_score - n
+
+
+	struct search_limits final {
+		int depth{std::numeric_limits<int>::max()};
+		std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+	};
+
+	struct search_info final {
+		int depth; //completed depth
+		int score; //centipawns from the perspective of the moving side
+		std::uint64_t nodes;
+		std::chrono::milliseconds time;
+		move best;
+	};
+
+	//iterative deepening alpha-beta search, report is invoked after every completed depth
+	// * returns the best move of the last completed depth (or the first legal move if not even depth 1 completed)
+	// * returns nothing if color has no legal moves
+	auto search(const chessboard & board, color color, search_limits limits, std::stop_token token = {}, const std::function<void(const search_info &)> & report = {}) -> std::optional<move>;
+}
@@ -0,0 +1,73 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <istream>
+#include <ostream>
+#include <iterator>
+#include <algorithm>
+#include "selfplay.hpp"
+
+namespace swo3 {
+	namespace {
+		constexpr
+		char magic[]{'T', 'E', 'S', 'P'};
+
+		constexpr
+		char version{1};
+
+		template<typename T>
+		void put(std::ostream & os, T value) {
+			for(std::size_t i{0}; i < sizeof(T); ++i) os.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+		}
+
+		template<typename T>
+		auto get(std::istream & is) -> T {
+			T result{0};
+			for(std::size_t i{0}; i < sizeof(T); ++i) {
+				const auto c{is.get()};
+				if(c == std::istream::traits_type::eof()) throw std::invalid_argument{"truncated game record"};
+				result |= static_cast<T>(static_cast<T>(c) << (8 * i));
+			}
+			return result;
+		}
+	}
+
+	game_writer::game_writer(std::ostream & os) : os{os} {
+		os.write(magic, sizeof(magic));
+		os.put(version);
+	}
+
+	void game_writer::write(const game_record & game) {
+		if(game.moves.size() > 0xFFFF) throw std::invalid_argument{"game too long"};
+		put(os, game.id);
+		put(os, game.start);
+		put(os, static_cast<std::uint8_t>(game.result));
+		put(os, static_cast<std::uint16_t>(game.moves.size()));
+		for(const auto & m : game.moves) put(os, static_cast<std::uint16_t>((m.from.rank * 8 + m.from.file) << 6 | (m.to.rank * 8 + m.to.file)));
+	}
+
+	game_reader::game_reader(std::istream & is) : is{is} {
+		char header[sizeof(magic) + 1];
+		if(!is.read(header, sizeof(header)) || !std::equal(std::begin(magic), std::end(magic), header) || header[sizeof(magic)] != version) throw std::invalid_argument{"not a self-play game file"};
+	}
+
+	auto game_reader::next() -> std::optional<game_record> {
+		if(is.peek() == std::istream::traits_type::eof()) return std::nullopt;
+		game_record result{};
+		result.id = get<std::uint32_t>(is);
+		result.start = get<std::uint16_t>(is);
+		const auto value{get<std::uint8_t>(is)};
+		if(value > static_cast<std::uint8_t>(outcome::unfinished)) throw std::invalid_argument{"unknown outcome in game record"};
+		result.result = static_cast<outcome>(value);
+		result.moves.resize(get<std::uint16_t>(is));
+		for(auto & m : result.moves) {
+			const auto encoded{get<std::uint16_t>(is)};
+			const auto from{encoded >> 6}, to{encoded & 0x3F};
+			m = {{from / 8, from % 8}, {to / 8, to % 8}};
+		}
+		return result;
+	}
+}
@@ -0,0 +1,89 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <iosfwd>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include "fen.hpp"
+#include "search.hpp"
+
+namespace swo3 {
+	enum class outcome : std::uint8_t { white_wins, black_wins, draw, unfinished, };
+
+
+	struct game_record final {
+		std::uint32_t id;          //sequence number of the game
+		std::uint16_t start;       //index of the start position
+		swo3::outcome result;
+		std::vector<move> moves;
+	};
+
+
+	//compact binary format: "TESP", version byte, then per game (all little-endian)
+	// * uint32 id, uint16 start, uint8 outcome, uint16 number of plies
+	// * uint16 per ply: from << 6 | to, with fields numbered rank * 8 + file (promotions are always to queens)
+	class game_writer final {
+		std::ostream & os;
+	public:
+		explicit
+		game_writer(std::ostream & os); //writes the header
+
+		void write(const game_record & game);
+	};
+
+	class game_reader final {
+		std::istream & is;
+	public:
+		explicit
+		game_reader(std::istream & is); //throws std::invalid_argument if the header doesn't match
+
+		auto next() -> std::optional<game_record>; //nothing at the end of the stream, throws std::invalid_argument for truncated records
+	};
+
+
+	struct selfplay_options final {
+		int depth{0};         //search depth per move, 0 picks uniformly random moves
+		int random_plies{8};  //number of initial plies that are always random to diversify searched games
+		int max_plies{400};   //games exceeding this are recorded as unfinished
+	};
+
+	//plays a game from start, the outcome is taken from chessboard::move
+	template<typename URBG>
+	requires std::uniform_random_bit_generator<std::remove_cvref_t<URBG>>
+	auto play(const position & start, const selfplay_options & options, URBG && gen) -> game_record {
+		game_record result{0, 0, outcome::unfinished, {}};
+		auto board{start.board};
+		auto turn{start.turn};
+		for(auto ply{0}; ply < options.max_plies; ++ply) {
+			const auto m{[&]() -> std::optional<move> {
+				if(options.depth > 0 && ply >= options.random_plies) return search(board, turn, {options.depth});
+				const auto moves{legal_moves(board, turn)};
+				if(moves.empty()) return std::nullopt;
+				return moves[std::uniform_int_distribution<std::size_t>{0, moves.size() - 1}(gen)];
+			}()};
+			if(!m) { //only reachable for start positions that are already over
+				result.result = board.test_in_check(turn) ? (turn == color::white ? outcome::black_wins : outcome::white_wins) : outcome::draw;
+				break;
+			}
+
+			result.moves.push_back(*m);
+			switch(board.move(*m)) {
+				case state::checkmate:
+					result.result = turn == color::white ? outcome::white_wins : outcome::black_wins;
+					return result;
+				case state::stalemate:
+					result.result = outcome::draw;
+					return result;
+				default:
+					turn = ~turn;
+			}
+		}
+		return result;
+	}
+}
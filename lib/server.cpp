@@ -0,0 +1,160 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <ostream>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include "server.hpp"
+#include "notation.hpp"
+#include "move_cache.hpp"
+#include "chesspieces.hpp"
+#include "instrumentation.hpp"
+
+namespace swo3 {
+	scheduler::scheduler(unsigned count) {
+		count = std::max(count, 1u); //hardware_concurrency is allowed to report 0
+		workers.reserve(count);
+		for(unsigned i{0}; i < count; ++i) workers.emplace_back([this](std::stop_token token) { run(token); });
+	}
+
+	scheduler::~scheduler() noexcept { for(auto & worker : workers) worker.request_stop(); }
+
+	void scheduler::post(std::shared_ptr<strand> strand, std::function<void()> task) {
+		{
+			std::scoped_lock lock{strand->mutex};
+			strand->tasks.push_back(std::move(task));
+			if(std::exchange(strand->scheduled, true)) return; //strand is already in flight and will pick up the task in order
+		}
+		{
+			std::scoped_lock lock{mutex};
+			ready.push_back(std::move(strand));
+		}
+		cv.notify_one();
+	}
+
+	void scheduler::run(std::stop_token token) {
+		for(;;) {
+			std::shared_ptr<strand> strand;
+			{
+				std::unique_lock lock{mutex};
+				if(!cv.wait(lock, token, [&] { return !ready.empty(); })) return; //stop was requested and nothing is left to do
+				strand = std::move(ready.front());
+				ready.pop_front();
+			}
+
+			std::function<void()> task;
+			{
+				std::scoped_lock lock{strand->mutex};
+				task = std::move(strand->tasks.front());
+				strand->tasks.pop_front();
+			}
+			task();
+
+			{
+				std::scoped_lock lock{strand->mutex};
+				if(strand->tasks.empty()) {
+					strand->scheduled = false;
+					continue;
+				}
+			}
+			//requeue at the back to not starve other strands
+			std::scoped_lock lock{mutex};
+			ready.push_back(std::move(strand));
+		}
+	}
+
+
+	auto serve(std::istream & in, std::ostream & out) -> int {
+		struct game final {
+			chessboard board{initial_board()};
+			color turn{color::white};
+			state result{state::ongoing};
+			scheduler::strand strand;
+		};
+
+		std::mutex out_mutex;
+		auto reply{[&](const std::string & id, const std::string & msg) {
+			std::scoped_lock lock{out_mutex};
+			out << id << ' ' << msg << std::endl;
+		}};
+
+		std::unordered_map<std::string, std::shared_ptr<game>> games; //only accessed by the reading thread
+		scheduler scheduler; //NOTE: must be destroyed before everything its tasks refer to
+
+		for(std::string line; std::getline(in, line);) {
+			std::istringstream tokens{line};
+			std::string command, id, argument;
+			tokens >> command >> id >> argument;
+
+			if(command == "quit") break;
+			if(command.empty()) continue;
+			if(command == "stats") { //global commands have no game id
+				std::ostringstream os;
+				const auto cache{move_cache::global().stats()};
+				os << "stats cache.hits=" << cache.hits << " cache.misses=" << cache.misses << " cache.evictions=" << cache.evictions << " cache.entries=" << cache.entries << " cache.bytes=" << cache.bytes;
+				if constexpr(instrumentation::enabled) os << ' ' << instrumentation::snapshot();
+				reply("-", os.str());
+				continue;
+			}
+			if(command == "trace") {
+				if(id == "start") {
+					instrumentation::start_tracing();
+					reply("-", "tracing");
+				} else if(id == "stop" && !argument.empty()) {
+					instrumentation::stop_tracing();
+					std::ofstream file{argument};
+					instrumentation::write_trace(file);
+					reply("-", file ? "traced" : "error unable to write " + argument);
+				} else reply("-", "error expected trace start|stop <file>");
+				continue;
+			}
+			if(id.empty()) {
+				reply("-", "error missing game id");
+				continue;
+			}
+
+			if(command == "new") {
+				if(!games.try_emplace(id, std::make_shared<game>()).second) reply(id, "error game already exists");
+				else reply(id, "created");
+				continue;
+			}
+
+			const auto it{games.find(id)};
+			if(it == games.end()) {
+				reply(id, "error unknown game");
+				continue;
+			}
+			const auto & g{it->second};
+			const std::shared_ptr<scheduler::strand> strand{g, &g->strand};
+
+			if(command == "move") scheduler.post(strand, [&reply, g, id, argument] {
+				try {
+					if(g->result != state::ongoing) throw std::logic_error{"game is over"};
+					const auto m{parse_move(argument)};
+					if(const auto & piece{std::as_const(g->board)[m.from]}; piece && piece->color() != g->turn) throw std::invalid_argument{"piece at " + to_string(m.from) + " does not belong to the side to move"};
+					g->result = g->board.move(m);
+					g->turn = ~g->turn;
+					switch(g->result) {
+						case state::checkmate: return reply(id, "checkmate");
+						case state::stalemate: return reply(id, "stalemate");
+						default:               return reply(id, "ok");
+					}
+				} catch(const std::exception & exc) {
+					reply(id, std::string{"error "} + exc.what());
+				}
+			});
+			else if(command == "close") {
+				scheduler.post(strand, [&reply, id] { reply(id, "closed"); }); //pending moves of this game are still answered first
+				games.erase(it);
+			} else reply(id, "error unknown command");
+		}
+		return 0;
+	}
+}
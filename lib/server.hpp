@@ -0,0 +1,56 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <deque>
+#include <mutex>
+#include <iosfwd>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+namespace swo3 {
+	class scheduler final { //fixed pool of workers multiplexing an arbitrary number of strands
+	public:
+		class strand final { //tasks posted to the same strand are executed in order and never concurrently
+			friend scheduler;
+
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+			bool scheduled{false}; //strand is either queued as ready or currently executed by a worker
+		};
+
+		explicit
+		scheduler(unsigned count = std::thread::hardware_concurrency());
+		scheduler(const scheduler &) =delete;
+		auto operator=(const scheduler &) -> scheduler & =delete;
+		~scheduler() noexcept; //drains all pending tasks
+
+		void post(std::shared_ptr<strand> strand, std::function<void()> task);
+	private:
+		void run(std::stop_token token);
+
+		std::mutex mutex;
+		std::condition_variable_any cv;
+		std::deque<std::shared_ptr<strand>> ready;
+		std::vector<std::jthread> workers; //NOTE: must be destroyed first
+	};
+
+
+	//line based protocol, every reply is prefixed with the id of the game it belongs to:
+	// * "new <id>"          => "<id> created"
+	// * "move <id> <move>"  => "<id> ok" | "<id> checkmate" | "<id> stalemate"
+	//                          white moves first, moves of the side not to move are rejected
+	// * "close <id>"        => "<id> closed"
+	// * "stats"             => "- stats <key>=<value>..." (move_cache statistics and, if built with CHESS_INSTRUMENTATION, instrumentation::stats)
+	// * "trace start"       => "- tracing"
+	// * "trace stop <file>" => "- traced", writes move phases since "trace start" as Chrome trace event JSON
+	// * "quit" or EOF       => terminates after all pending moves have been processed
+	// * errors              => "<id> error <reason>"
+	auto serve(std::istream & in, std::ostream & out) -> int;
+}
@@ -0,0 +1,497 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <map>
+#include <bit>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <cctype>
+#include <limits>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include "fen.hpp"
+#include "tablebase.hpp"
+
+namespace swo3 {
+	namespace {
+		using index = std::uint64_t;
+		using slot = std::pair<color, glyph>;
+
+		//file layout: magic (4 bytes), version, piece count, black pieces (bit mask), symmetry, glyphs (8 bytes), values (int16, little endian)
+		constexpr
+		char magic[]{'T', 'E', 'T', 'B'};
+
+		constexpr
+		std::uint8_t version{2};
+
+		constexpr
+		std::size_t header_size{16}, max_pieces{8};
+
+		//values are stored from the perspective of the moving side: win in n plies => n, loss in n plies => -(n + 1), draw => 0
+		//illegal positions (side not to move in check) and non-canonical duplicates of symmetric positions are stored as illegal
+		constexpr
+		std::int16_t unresolved{std::numeric_limits<std::int16_t>::min()}, illegal{unresolved + 1};
+
+		constexpr
+		auto value_for(int ply) noexcept -> std::int16_t { return static_cast<std::int16_t>(ply % 2 ? ply : -(ply + 1)); } //winning plies are odd, losing plies are even
+
+		constexpr
+		auto entry_for(std::int16_t value) noexcept -> tablebase_entry {
+			if(value > 0) return {wdl::win, value};
+			if(value < 0) return {wdl::loss, -value - 1};
+			return {wdl::draw, 0};
+		}
+
+		constexpr
+		auto to_pos(int square) noexcept -> pos { return {square / 8, square % 8}; }
+
+		auto order(const slot & slot) noexcept -> std::pair<color, int> { //canonical order: white before black, standard pieces by value, others by glyph
+			constexpr std::string_view standard{"KQRBNP"};
+			const auto upper{static_cast<char>(std::toupper(static_cast<unsigned char>(slot.second)))};
+			const auto pos{standard.find(upper)};
+			return {slot.first, pos == std::string_view::npos ? static_cast<int>(standard.size()) + static_cast<unsigned char>(upper) : static_cast<int>(pos)};
+		}
+
+		auto name_of(std::vector<slot> slots) -> std::string {
+			std::ranges::sort(slots, {}, order);
+			std::string result;
+			auto white{true};
+			for(const auto & [c, g] : slots) {
+				if(c == color::black && std::exchange(white, false)) result += 'v';
+				result += static_cast<char>(std::toupper(static_cast<unsigned char>(g)));
+			}
+			if(white) result += 'v';
+			return result;
+		}
+
+		enum class symmetry : std::uint8_t { //of the board, preserved by the rules of all pieces of a table
+			none,     //custom pieces
+			mirror,   //standard pieces with pawns: files a-h <=> h-a
+			dihedral, //standard pieces without pawns: mirroring files, ranks and the a1-h8 diagonal
+		};
+
+		auto symmetry_of(std::span<const chesspiece> pieces) -> symmetry {
+			auto result{symmetry::dihedral};
+			for(const auto & piece : pieces) {
+				const auto standard{[&] {
+					try {
+						return piece.same_type(parse_piece(piece.glyph()));
+					} catch(const std::invalid_argument &) {
+						return false;
+					}
+				}()};
+				if(!standard) return symmetry::none;
+				if(piece.promotable()) result = symmetry::mirror;
+			}
+			return result;
+		}
+
+		constexpr
+		auto transforms(symmetry sym) noexcept -> unsigned { return sym == symmetry::dihedral ? 8 : sym == symmetry::mirror ? 2 : 1; }
+
+		constexpr
+		auto transform(int square, unsigned t) noexcept -> int { //t: bit 0 mirrors files, bit 1 mirrors ranks, bit 2 mirrors the diagonal
+			auto rank{square / 8}, file{square % 8};
+			if(t & 4) std::swap(rank, file);
+			if(t & 2) rank = 7 - rank;
+			if(t & 1) file = 7 - file;
+			return rank * 8 + file;
+		}
+
+		//the first piece of a table is confined to a region that contains at least one square of every symmetry class
+		constexpr
+		auto region_size(symmetry sym) noexcept -> index { return sym == symmetry::dihedral ? 10 : sym == symmetry::mirror ? 32 : 64; }
+
+		constexpr
+		auto region(int square, symmetry sym) noexcept -> int { //index of square within region, -1 if outside
+			const auto rank{square / 8}, file{square % 8};
+			switch(sym) {
+				case symmetry::none:     return square;
+				case symmetry::mirror:   return file < 4 ? rank * 4 + file : -1;
+				case symmetry::dihedral: return rank <= file && file < 4 ? 3 * rank - rank * (rank - 1) / 2 + file : -1; //triangle a8-d8-d5
+				default: internal::unreachable();
+			}
+		}
+
+		constexpr
+		auto table_size(std::size_t pieces, symmetry sym) noexcept -> index { //first piece within region, every other piece on one of the remaining squares, side to move
+			if(pieces == 0) return 2;
+			auto result{region_size(sym) * 2};
+			for(std::size_t k{1}; k < pieces; ++k) result *= 64 - k;
+			return result;
+		}
+
+		auto encode(std::span<const int> squares, color turn, symmetry sym) noexcept -> index { //precondition: distinct squares, first one within region
+			if(squares.empty()) return turn == color::white ? 0 : 1;
+			index result{static_cast<index>(region(squares[0], sym))};
+			auto used{std::uint64_t{1} << squares[0]};
+			for(std::size_t k{1}; k < squares.size(); ++k) {
+				const auto bit{std::uint64_t{1} << squares[k]};
+				result = result * (64 - k) + static_cast<index>(squares[k] - std::popcount(used & (bit - 1))); //rank among unused squares
+				used |= bit;
+			}
+			return result * 2 + (turn == color::white ? 0 : 1);
+		}
+
+		auto decode(index idx, std::span<int> squares, symmetry sym) noexcept -> color {
+			const auto turn{idx % 2 ? color::black : color::white};
+			if(squares.empty()) return turn;
+			idx /= 2;
+			for(auto k{squares.size() - 1}; k > 0; --k) {
+				squares[k] = static_cast<int>(idx % (64 - k));
+				idx /= 64 - k;
+			}
+			for(auto square{0}; square < 64; ++square)
+				if(region(square, sym) == static_cast<int>(idx))
+					squares[0] = square;
+
+			auto used{std::uint64_t{1} << squares[0]};
+			for(std::size_t k{1}; k < squares.size(); ++k) {
+				auto rank{squares[k]}, square{0}; //rank among unused squares
+				while(used & (std::uint64_t{1} << square) || rank-- > 0) ++square;
+				squares[k] = square;
+				used |= std::uint64_t{1} << square;
+			}
+			return turn;
+		}
+
+		//index of the canonical form of a position (minimum over all symmetric forms) and the transforms that yield it
+		auto canonical(std::span<const int> squares, color turn, symmetry sym) noexcept -> std::pair<index, unsigned> {
+			if(squares.empty()) return {encode(squares, turn, sym), 1u};
+			std::pair result{std::numeric_limits<index>::max(), 0u};
+			std::array<int, max_pieces> transformed;
+			for(unsigned t{0}; t < transforms(sym); ++t) {
+				if(region(transform(squares[0], t), sym) == -1) continue;
+				for(std::size_t i{0}; i < squares.size(); ++i) transformed[i] = transform(squares[i], t);
+				const auto idx{encode({transformed.data(), squares.size()}, turn, sym)};
+				if(idx < result.first) result = {idx, 1u << t};
+				else if(idx == result.first) result.second |= 1u << t;
+			}
+			return result;
+		}
+
+		auto index_of(std::span<const slot> slots, symmetry sym, const chessboard & board, color turn) noexcept -> std::optional<index> {
+			std::array<int, max_pieces> squares;
+			std::size_t count{0};
+			for(auto square{0}; square < 64; ++square)
+				if(board[to_pos(square)])
+					++count;
+			if(count != slots.size()) return std::nullopt;
+
+			std::uint64_t used{0};
+			for(std::size_t i{0}; i < slots.size(); ++i) {
+				auto square{0};
+				for(; square < 64; ++square)
+					if(const auto & piece{board[to_pos(square)]}; !(used & (std::uint64_t{1} << square)) && piece && piece->color() == slots[i].first && piece->glyph() == slots[i].second)
+						break;
+				if(square == 64) return std::nullopt;
+				used |= std::uint64_t{1} << square;
+				squares[i] = square;
+			}
+			return canonical({squares.data(), slots.size()}, turn, sym).first;
+		}
+
+		void parallel_for(index count, unsigned threads, const std::function<void(index, index)> & body) {
+			constexpr index chunk{1 << 12};
+			std::atomic<index> next{0};
+			std::vector<std::jthread> workers;
+			for(unsigned i{0}; i < std::max(threads, 1u); ++i)
+				workers.emplace_back([&] {
+					for(index first; (first = next.fetch_add(chunk)) < count;)
+						body(first, std::min(first + chunk, count));
+				});
+		}
+
+
+		struct table final {
+			std::vector<slot> slots;
+			symmetry sym;
+			std::vector<std::int16_t> values;
+		};
+
+		class builder final {
+			unsigned threads;
+			const std::filesystem::path & directory;
+			const std::function<void(std::string_view)> & progress;
+			std::map<std::string, table> tables; //NOTE: node based, references stay valid
+		public:
+			builder(unsigned threads, const std::filesystem::path & directory, const std::function<void(std::string_view)> & progress) : threads{threads}, directory{directory}, progress{progress} {}
+
+			auto build(std::vector<chesspiece> pieces) -> const table & {
+				std::ranges::sort(pieces, {}, [](const chesspiece & piece) { return order({piece.color(), piece.glyph()}); });
+				std::vector<slot> slots;
+				for(const auto & piece : pieces) slots.emplace_back(piece.color(), piece.glyph());
+				if(slots.size() > max_pieces) throw std::invalid_argument{"too many pieces for tablebase"};
+
+				const auto name{name_of(slots)};
+				if(const auto it{tables.find(name)}; it != tables.end()) return it->second;
+
+				//tables reachable via captures and promotions must be available before this one
+				for(std::size_t i{0}; i < pieces.size(); ++i) {
+					if(!pieces[i].essential()) {
+						auto captured{pieces};
+						captured.erase(captured.begin() + static_cast<std::ptrdiff_t>(i));
+						build(std::move(captured));
+					}
+					for(const auto rank : {0, 7})
+						if(auto promoted{pieces[i]}; promoted.promote({rank, 0}), promoted.glyph() != pieces[i].glyph()) {
+							auto copy{pieces};
+							copy[i] = promoted;
+							build(std::move(copy));
+						}
+				}
+
+				const auto sym{symmetry_of(pieces)};
+				auto & result{tables.emplace(name, table{std::move(slots), sym, generate(pieces, sym)}).first->second};
+				write(directory / (name + ".tetb"), result);
+				if(progress) progress(name);
+				return result;
+			}
+		private:
+			auto lookup(const chessboard & board, color turn) const noexcept -> std::int16_t {
+				std::vector<slot> slots;
+				for(auto square{0}; square < 64; ++square)
+					if(const auto & piece{board[to_pos(square)]})
+						slots.emplace_back(piece->color(), piece->glyph());
+				const auto & table{tables.at(name_of(slots))};
+				return table.values[*index_of(table.slots, table.sym, board, turn)];
+			}
+
+			auto generate(const std::vector<chesspiece> & pieces, symmetry sym) const -> std::vector<std::int16_t> {
+				const auto n{pieces.size()};
+				const auto size{table_size(n, sym)};
+
+				//pieces that promote can never stand on the first or last rank and are only unmoved on their initial rank
+				std::vector<int> initial_rank(n, -1);
+				for(std::size_t i{0}; i < n; ++i)
+					for(const auto rank : {0, 7})
+						if(auto copy{pieces[i]}; copy.promote({rank, 0}), copy.glyph() != pieces[i].glyph())
+							initial_rank[i] = rank == 0 ? 6 : 1;
+
+				const auto place{[&](chessboard & board, std::size_t i, int square) {
+					auto piece{pieces[i]};
+					if(square / 8 != initial_rank[i]) piece.mark_as_moved(); //no castling
+					board[to_pos(square)] = piece;
+				}};
+				const auto valid_placement{[&](std::span<const int> squares) {
+					std::uint64_t used{0};
+					for(std::size_t i{0}; i < n; ++i) {
+						const auto bit{std::uint64_t{1} << squares[i]};
+						if(used & bit) return false;
+						used |= bit;
+						if(initial_rank[i] != -1 && (squares[i] / 8 == 0 || squares[i] / 8 == 7)) return false;
+					}
+					return true;
+				}};
+
+				std::vector<std::atomic<std::int16_t>> values(size);
+				std::vector<std::atomic<std::uint8_t>> remaining(size); //number of moves staying within this table that are not yet known to lose
+				std::vector<std::int16_t> floor(size); //earliest ply a position can be lost at due to moves leaving this table, -1 if such a move doesn't lose
+
+				std::mutex mutex;
+				std::map<int, std::vector<index>> scheduled; //positions whose value is determined by moves leaving this table
+				const auto merge{[&](std::map<int, std::vector<index>> & local) {
+					std::scoped_lock lock{mutex};
+					for(auto & [ply, indices] : local) scheduled[ply].insert(scheduled[ply].end(), indices.begin(), indices.end());
+				}};
+
+				//forward pass: count moves, resolve mates, and evaluate moves leaving this table (captures and promotions)
+				parallel_for(size, threads, [&](index first, index last) {
+					std::map<int, std::vector<index>> local;
+					std::array<int, max_pieces> squares;
+					for(auto idx{first}; idx < last; ++idx) {
+						const auto turn{decode(idx, {squares.data(), n}, sym)};
+						if(!valid_placement({squares.data(), n}) || canonical({squares.data(), n}, turn, sym).first != idx) {
+							values[idx] = illegal;
+							continue;
+						}
+						chessboard board;
+						for(std::size_t i{0}; i < n; ++i) place(board, i, squares[i]);
+						if(board.test_in_check(~turn)) {
+							values[idx] = illegal;
+							continue;
+						}
+						values[idx] = unresolved;
+
+						auto any{false}, escape{false};
+						auto win{std::numeric_limits<int>::max()}, out_floor{0};
+						std::uint8_t count{0};
+						for(std::size_t i{0}; i < n; ++i) {
+							if(pieces[i].color() != turn) continue;
+							const auto from{to_pos(squares[i])};
+							for(auto square{0}; square < 64; ++square) {
+								const move m{from, to_pos(square)};
+								const auto result{board[from]->is_valid_move(board, m)};
+								if(!result) continue;
+								any = true;
+
+								auto next{board};
+								for(const auto & step : result.value_or(m)) next[step.to] = std::exchange(next[step.from], {});
+								next[m.to]->promote(m.to);
+								if(!board[m.to] && next[m.to]->glyph() == pieces[i].glyph()) {
+									++count;
+									continue;
+								}
+
+								const auto value{lookup(next, ~turn)};
+								if(value < 0) win = std::min<int>(win, -value);
+								else if(value == 0) escape = true;
+								else out_floor = std::max(out_floor, value + 1);
+							}
+						}
+
+						remaining[idx] = count;
+						if(!any) {
+							if(board.test_in_check(turn)) local[0].push_back(idx); //checkmate, otherwise stalemate
+							continue;
+						}
+						floor[idx] = static_cast<std::int16_t>(escape || win != std::numeric_limits<int>::max() ? -1 : out_floor);
+						if(win != std::numeric_limits<int>::max()) local[win].push_back(idx);
+						else if(count == 0 && !escape) local[out_floor].push_back(idx);
+					}
+					merge(local);
+				});
+
+				//retrograde pass: resolve positions ply by ply, propagating to all predecessors within this table
+				// * callback receives every canonical predecessor together with the move target as seen from the predecessor's canonical form (packed squares)
+				// * self-symmetric positions report the same move more than once, these are identified by equal targets
+				const auto for_each_predecessor{[&](index idx, auto && callback) {
+					std::array<int, max_pieces> squares;
+					const auto turn{decode(idx, {squares.data(), n}, sym)};
+					chessboard board;
+					for(std::size_t i{0}; i < n; ++i) place(board, i, squares[i]);
+
+					for(std::size_t i{0}; i < n; ++i) {
+						if(pieces[i].color() == turn) continue; //the piece that moved last belongs to the other side
+						const auto to{squares[i]};
+						auto piece{std::exchange(board[to_pos(to)], {})};
+						for(auto from{0}; from < 64; ++from) {
+							if(board[to_pos(from)]) continue;
+							squares[i] = from;
+							if(!valid_placement({squares.data(), n})) continue;
+							const auto [pred, forms]{canonical({squares.data(), n}, ~turn, sym)};
+							if(values[pred] == illegal) continue;
+							place(board, i, from);
+							if(board[to_pos(from)]->is_valid_move(board, {to_pos(from), to_pos(to)}))
+								for(unsigned t{0}; t < transforms(sym); ++t)
+									if(forms & (1u << t)) {
+										std::uint64_t packed{0};
+										for(std::size_t j{0}; j < n; ++j) packed = packed << 6 | static_cast<std::uint64_t>(transform(j == i ? to : squares[j], t));
+										callback(pred, packed);
+									}
+							board[to_pos(from)].reset();
+						}
+						squares[i] = to;
+						board[to_pos(to)] = std::move(piece);
+					}
+				}};
+
+				std::vector<index> current;
+				for(auto ply{0}; ply < std::numeric_limits<std::int16_t>::max() - 1; ++ply) {
+					if(const auto it{scheduled.find(ply)}; it != scheduled.end()) {
+						current.insert(current.end(), it->second.begin(), it->second.end());
+						scheduled.erase(it);
+					}
+					if(current.empty()) {
+						if(scheduled.empty()) break;
+						continue;
+					}
+
+					std::vector<index> next;
+					parallel_for(current.size(), threads, [&](index first, index last) {
+						std::vector<index> local_next;
+						std::map<int, std::vector<index>> local_later;
+						std::vector<std::pair<index, std::uint64_t>> losing;
+						for(auto k{first}; k < last; ++k) {
+							const auto idx{current[k]};
+							auto expected{unresolved};
+							if(!values[idx].compare_exchange_strong(expected, value_for(ply))) continue; //already resolved earlier
+
+							if(ply % 2 == 0) { //moving into a lost position wins
+								for_each_predecessor(idx, [&](index pred, std::uint64_t) { local_next.push_back(pred); });
+								continue;
+							}
+
+							losing.clear(); //every move into idx loses, each must be counted exactly once
+							for_each_predecessor(idx, [&](index pred, std::uint64_t target) { losing.emplace_back(pred, target); });
+							std::ranges::sort(losing);
+							losing.erase(std::ranges::unique(losing).begin(), losing.end());
+							for(const auto & [pred, target] : losing)
+								if(remaining[pred].fetch_sub(1) == 1) //all moves within this table lose
+									if(const auto f{floor[pred]}; f != -1) {
+										if(f <= ply + 1) local_next.push_back(pred);
+										else local_later[f].push_back(pred);
+									}
+						}
+						merge(local_later);
+						std::scoped_lock lock{mutex};
+						next.insert(next.end(), local_next.begin(), local_next.end());
+					});
+					current = std::move(next);
+				}
+
+				decltype(remaining){}.swap(remaining);
+				decltype(floor){}.swap(floor);
+				std::vector<std::int16_t> result(size);
+				for(index idx{0}; idx < size; ++idx)
+					if(const auto value{values[idx].load()}; value != unresolved) //unresolved positions are draws
+						result[idx] = value;
+				return result;
+			}
+
+			static
+			void write(const std::filesystem::path & path, const table & table) {
+				std::ofstream os{path, std::ios::binary};
+				os.write(magic, sizeof(magic));
+				std::uint8_t blacks{0};
+				for(std::size_t i{0}; i < table.slots.size(); ++i)
+					if(table.slots[i].first == color::black)
+						blacks |= static_cast<std::uint8_t>(1 << i);
+				os.put(static_cast<char>(version)).put(static_cast<char>(table.slots.size())).put(static_cast<char>(blacks)).put(static_cast<char>(table.sym));
+				for(std::size_t i{0}; i < max_pieces; ++i) os.put(i < table.slots.size() ? table.slots[i].second : '\0');
+				for(const auto value : table.values) {
+					const auto raw{static_cast<std::uint16_t>(value)};
+					os.put(static_cast<char>(raw & 0xFF)).put(static_cast<char>(raw >> 8));
+				}
+				if(!os) throw std::runtime_error{"failed to write " + path.string()};
+			}
+		};
+	}
+
+	auto tablebase_name(const chessboard & board) -> std::string {
+		std::vector<slot> slots;
+		for(auto square{0}; square < 64; ++square)
+			if(const auto & piece{board[to_pos(square)]})
+				slots.emplace_back(piece->color(), piece->glyph());
+		return name_of(std::move(slots));
+	}
+
+	void generate_tablebases(std::span<const chesspiece> material, const std::filesystem::path & directory, unsigned threads, const std::function<void(std::string_view)> & progress) {
+		builder{threads, directory, progress}.build({material.begin(), material.end()});
+	}
+
+	tablebase::tablebase(const std::filesystem::path & path) : file{path} {
+		const auto bytes{file.bytes()};
+		if(bytes.size() < header_size || std::memcmp(bytes.data(), magic, sizeof(magic)) || std::to_integer<std::uint8_t>(bytes[4]) != version) throw std::invalid_argument{"invalid tablebase: unknown format"};
+		const auto count{std::to_integer<std::size_t>(bytes[5])};
+		const auto blacks{std::to_integer<unsigned>(bytes[6])};
+		sym = std::to_integer<std::uint8_t>(bytes[7]);
+		if(sym > static_cast<std::uint8_t>(symmetry::dihedral)) throw std::invalid_argument{"invalid tablebase: unknown symmetry"};
+		if(count > max_pieces || bytes.size() != header_size + table_size(count, static_cast<symmetry>(sym)) * 2) throw std::invalid_argument{"invalid tablebase: size mismatch"};
+		for(std::size_t i{0}; i < count; ++i) slots.emplace_back(blacks & (1u << i) ? color::black : color::white, std::to_integer<char>(bytes[8 + i]));
+	}
+
+	auto tablebase::probe(const chessboard & board, color turn) const noexcept -> std::optional<tablebase_entry> {
+		const auto idx{index_of(slots, static_cast<symmetry>(sym), board, turn)};
+		if(!idx) return std::nullopt;
+		const auto data{file.bytes().data() + header_size + *idx * 2};
+		const auto value{static_cast<std::int16_t>(std::to_integer<std::uint16_t>(data[0]) | (std::to_integer<std::uint16_t>(data[1]) << 8))};
+		if(value == illegal) return std::nullopt;
+		return entry_for(value);
+	}
+}
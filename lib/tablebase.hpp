@@ -0,0 +1,52 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <functional>
+#include <string_view>
+#include "chess.hpp"
+#include "mapped_file.hpp"
+
+namespace swo3 {
+	enum class wdl { loss, draw, win, };
+
+
+	struct tablebase_entry final {
+		wdl result; //from the perspective of the moving side
+		int plies;  //distance to mate, 0 for draws
+	};
+
+
+	//name of the table covering board, e.g. "KQvK" (white pieces, 'v', black pieces; all upper case)
+	auto tablebase_name(const chessboard & board) -> std::string;
+
+	//generates the table for material and all tables reachable from it via captures and promotions by retrograde analysis
+	// * rules are taken from the pieces themselves, therefore custom (essential) pieces are supported
+	// * castling and en passant are not considered
+	// * every table is written as "<name>.tetb" to directory, progress is reported with the name of every finished table
+	// * positions are indexed up to symmetry (8-fold without pawns, 2-fold with pawns, none for custom pieces) and without overlapping pieces
+	// * file size is 2 bytes and peak memory about 5 bytes per indexed position, e.g. 0.6 GB and 1.4 GB for 5 pieces without pawns (1.8 GB and 4.6 GB with pawns)
+	void generate_tablebases(std::span<const chesspiece> material, const std::filesystem::path & directory, unsigned threads = std::thread::hardware_concurrency(), const std::function<void(std::string_view)> & progress = {});
+
+
+	class tablebase final { //memory-mapped table as created by generate_tablebases
+		mapped_file file;
+		std::vector<std::pair<color, glyph>> slots; //order of pieces in index
+		std::uint8_t sym; //symmetry of index
+	public:
+		explicit
+		tablebase(const std::filesystem::path & path); //throws std::system_error or std::invalid_argument
+
+		//returns nothing if the material on board doesn't match this table or the side not to move is in check
+		auto probe(const chessboard & board, color turn) const noexcept -> std::optional<tablebase_entry>;
+	};
+}
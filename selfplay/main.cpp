@@ -0,0 +1,112 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include <selfplay.hpp>
+
+namespace {
+	using namespace swo3;
+
+	auto usage() -> int {
+		std::cerr << "usage: chess-selfplay play <output> [--games <n>] [--threads <n>] [--depth <n>] [--random-plies <n>] [--max-plies <n>] [--seed <n>] [--positions <file with one FEN per line>]\n"
+		             "       chess-selfplay print <input>\n";
+		return 1;
+	}
+
+	auto print(const std::filesystem::path & input) -> int {
+		std::ifstream is{input, std::ios::binary};
+		if(!is) throw std::invalid_argument{"unable to open " + input.string()};
+		game_reader reader{is};
+		while(const auto game{reader.next()}) {
+			static constexpr std::string_view results[]{"1-0", "0-1", "1/2-1/2", "*"};
+			std::cout << game->id << ' ' << game->start << ' ' << results[static_cast<int>(game->result)];
+			for(const auto & m : game->moves) {
+				std::cout << ' ';
+				for(const auto & p : {m.from, m.to}) std::cout << static_cast<char>('a' + p.file) << static_cast<char>('8' - p.rank);
+			}
+			std::cout << '\n';
+		}
+		return 0;
+	}
+}
+
+int main(int argc, char * argv[]) try {
+	if(argc < 3) return usage();
+	const std::string_view command{argv[1]};
+	if(command == "print") return print(argv[2]);
+	if(command != "play") return usage();
+
+	const std::filesystem::path output{argv[2]};
+	std::uint32_t games{1000};
+	unsigned threads{std::max(std::thread::hardware_concurrency(), 1u)};
+	std::uint64_t seed{std::random_device{}()};
+	selfplay_options options;
+	std::vector<position> positions;
+	for(auto i{3}; i < argc; ++i) {
+		const std::string_view arg{argv[i]};
+		if(i + 1 == argc) return usage();
+		const std::string value{argv[++i]};
+		if(arg == "--games") games = static_cast<std::uint32_t>(std::stoul(value));
+		else if(arg == "--threads") threads = std::max(1u, static_cast<unsigned>(std::stoul(value)));
+		else if(arg == "--depth") options.depth = std::stoi(value);
+		else if(arg == "--random-plies") options.random_plies = std::stoi(value);
+		else if(arg == "--max-plies") options.max_plies = std::min(std::stoi(value), 0xFFFF);
+		else if(arg == "--seed") seed = std::stoull(value);
+		else if(arg == "--positions") {
+			std::ifstream is{value};
+			if(!is) throw std::invalid_argument{"unable to open " + value};
+			for(std::string line; std::getline(is, line);)
+				if(!line.empty()) positions.push_back(parse_fen(line));
+		} else return usage();
+	}
+	if(positions.empty()) positions.push_back(parse_fen(startpos_fen));
+	if(positions.size() > 0x10000) throw std::invalid_argument{"too many start positions"};
+
+	std::ofstream os{output, std::ios::binary};
+	if(!os) throw std::invalid_argument{"unable to open " + output.string()};
+	game_writer writer{os};
+	std::mutex mutex; //guards writer and plies
+	std::uint64_t plies{0};
+
+	const auto start{std::chrono::steady_clock::now()};
+	{
+		std::atomic<std::uint32_t> next{0};
+		std::vector<std::jthread> workers;
+		for(unsigned t{0}; t < threads; ++t)
+			workers.emplace_back([&] {
+				for(std::uint32_t id; (id = next++) < games;) {
+					const auto index{id % positions.size()};
+					std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32), id}; //every game is reproducible on its own, regardless of thread count
+					std::mt19937_64 gen{sequence};
+
+					auto game{play(positions[index], options, gen)};
+					game.id = id;
+					game.start = static_cast<std::uint16_t>(index);
+
+					std::scoped_lock lock{mutex};
+					writer.write(game);
+					plies += game.moves.size();
+				}
+			});
+	}
+	const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+	std::cerr << "played " << games << " games (" << plies << " plies) in " << elapsed.count() << "s, " << games / elapsed.count() << " games/s\n";
+	return os ? 0 : 1;
+} catch(const std::exception & exc) {
+	std::cerr << "ERR: " << exc.what() << "\n";
+	return 1;
+}
@@ -0,0 +1,57 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cctype>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <string_view>
+#include <fen.hpp>
+#include <tablebase.hpp>
+
+namespace {
+	auto parse_material(std::string_view spec) -> std::vector<swo3::chesspiece> { //e.g. "KQvK"
+		const auto separator{spec.find('v')};
+		if(separator == std::string_view::npos) throw std::invalid_argument{"material must be given as <white>v<black>, e.g. KQvK"};
+		std::vector<swo3::chesspiece> result;
+		for(std::size_t i{0}; i < spec.size(); ++i)
+			if(i < separator) result.push_back(swo3::parse_piece(spec[i]));
+			else if(i > separator) result.push_back(swo3::parse_piece(static_cast<char>(std::tolower(static_cast<unsigned char>(spec[i])))));
+		return result;
+	}
+
+	auto usage() -> int {
+		std::cerr << "usage: chess-tablebase generate <directory> <material>  (e.g. KQvK)\n"
+		             "       chess-tablebase probe <directory> <fen>\n";
+		return 1;
+	}
+}
+
+int main(int argc, char * argv[]) try {
+	if(argc < 4) return usage();
+	const std::string_view command{argv[1]};
+	const std::filesystem::path directory{argv[2]};
+
+	if(command == "generate") {
+		std::filesystem::create_directories(directory);
+		swo3::generate_tablebases(parse_material(argv[3]), directory, std::thread::hardware_concurrency(), [](std::string_view name) { std::cout << "generated " << name << std::endl; });
+	} else if(command == "probe") {
+		std::string fen;
+		for(auto i{3}; i < argc; ++i) fen += std::string{argv[i]} + ' ';
+		const auto position{swo3::parse_fen(fen)};
+		const swo3::tablebase tb{directory / (swo3::tablebase_name(position.board) + ".tetb")};
+		const auto entry{tb.probe(position.board, position.turn)};
+		if(!entry) throw std::invalid_argument{"position is illegal or not covered by tablebase"};
+		switch(entry->result) {
+			case swo3::wdl::win:  std::cout << "win in " << entry->plies << " plies\n"; break;
+			case swo3::wdl::loss: std::cout << "loss in " << entry->plies << " plies\n"; break;
+			case swo3::wdl::draw: std::cout << "draw\n"; break;
+		}
+	} else return usage();
+} catch(const std::exception & exc) {
+	std::cerr << "ERR: " << exc.what() << "\n";
+	return 1;
+}
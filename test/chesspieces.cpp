@@ -115,3 +115,80 @@ TEST_CASE("Casteling king", "[king] [move]") {
 	REQUIRE(!b[from]->is_valid_move(b, {from, "G1"}));
 	REQUIRE(!b[from]->is_valid_move(b, {from, "C1"}));
 }
+
+TEST_CASE("Executing casteling", "[king] [move]") {
+	swo3::chessboard b;
+	b["E1"] = swo3::king<swo3::color::white>{};
+	b["H1"] = b["A1"] = swo3::rook<swo3::color::white>{};
+
+	auto copy{b};
+	copy.move({"E1", "G1"});
+	REQUIRE(!copy["E1"]);
+	REQUIRE(!copy["H1"]);
+	REQUIRE(copy["G1"]->glyph() == swo3::king<swo3::color::white>::glyph);
+	REQUIRE(copy["F1"]->glyph() == swo3::rook<swo3::color::white>::glyph);
+
+	b.move({"E1", "C1"});
+	REQUIRE(!b["E1"]);
+	REQUIRE(!b["A1"]);
+	REQUIRE(!b["B1"]);
+	REQUIRE(b["C1"]->glyph() == swo3::king<swo3::color::white>::glyph);
+	REQUIRE(b["D1"]->glyph() == swo3::rook<swo3::color::white>::glyph);
+}
+
+TEST_CASE("Pinned pieces still give check", "[king]") {
+	swo3::chessboard b;
+	b["H3"] = swo3::king<swo3::color::white>{};
+	b["H1"] = swo3::queen<swo3::color::white>{};
+	b["H5"] = swo3::king<swo3::color::black>{};
+	REQUIRE(!b["H3"]->is_valid_move(b, {"H3", "H4"})); //black king couldn't capture on h4 as it would walk into the queen, but still guards it
+	REQUIRE(b["H3"]->is_valid_move(b, {"H3", "G2"}));
+}
+
+TEST_CASE("Adjudicating insufficient material", "[stalemate] [move]") {
+	swo3::chessboard b;
+	b["E1"] = swo3::king<swo3::color::white>{};
+	b["B1"] = swo3::knight<swo3::color::white>{};
+	b["E8"] = swo3::king<swo3::color::black>{};
+	b["E2"] = swo3::rook<swo3::color::black>{};
+	REQUIRE(b.move({"E1", "E2"}) == swo3::state::stalemate); //king and knight vs king
+
+	swo3::chessboard same;
+	same["A1"] = swo3::king<swo3::color::white>{};
+	same["E3"] = swo3::bishop<swo3::color::white>{};
+	same["H2"] = swo3::king<swo3::color::black>{};
+	same["F8"] = swo3::bishop<swo3::color::black>{};
+	same["D4"] = swo3::knight<swo3::color::black>{};
+	auto opposite{same};
+	REQUIRE(same.move({"E3", "D4"}) == swo3::state::stalemate); //bishops on dark squares only
+
+	opposite["F8"] = {};
+	opposite["E8"] = swo3::bishop<swo3::color::black>{};
+	REQUIRE(opposite.move({"E3", "D4"}) == swo3::state::ongoing); //bishops on squares of both colors
+	REQUIRE(opposite.move({"E8", "F7"}) == swo3::state::ongoing);
+	opposite["F7"] = {}; //material changed behind the board's back
+	REQUIRE(opposite.move({"D4", "C5"}) == swo3::state::stalemate);
+}
+
+TEST_CASE("Adjudicating fifty move rule", "[stalemate] [move]") {
+	swo3::chessboard b;
+	b["E1"] = swo3::king<swo3::color::white>{};
+	b["A1"] = swo3::rook<swo3::color::white>{};
+	b["E8"] = swo3::king<swo3::color::black>{};
+	b["H7"] = swo3::pawn<swo3::color::black>{};
+	b.halfmove_clock(97);
+
+	REQUIRE(b.move({"A1", "A2"}) == swo3::state::ongoing);
+	REQUIRE(b.halfmove_clock() == 98);
+	REQUIRE(b.move({"H7", "H6"}) == swo3::state::ongoing); //pawn moves reset the clock
+	REQUIRE(b.halfmove_clock() == 0);
+
+	b.halfmove_clock(98);
+	REQUIRE(b.move({"A2", "A3"}) == swo3::state::ongoing);
+	REQUIRE(b.move({"E8", "D8"}) == swo3::state::stalemate);
+
+	b.halfmove_clock(98);
+	b["A6"] = swo3::knight<swo3::color::black>{};
+	REQUIRE(b.move({"A3", "A6"}) == swo3::state::ongoing); //captures reset the clock
+	REQUIRE(b.halfmove_clock() == 0);
+}
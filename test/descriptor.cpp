@@ -0,0 +1,107 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <catch.hpp>
+#include <fen.hpp>
+#include <descriptor.hpp>
+#include <chesspieces.hpp>
+
+namespace {
+	using swo3::color;
+
+	template<color Color>
+	using described_knight = swo3::described<Color, Color == color::white ? 'N' : 'n', [] { auto d{swo3::leaper(1, 2)}; d.minor = true; return d; }()>;
+
+	template<color Color>
+	using described_bishop = swo3::described<Color, Color == color::white ? 'B' : 'b', [] { auto d{swo3::rider(1, 1)}; d.minor = true; return d; }()>;
+
+	template<color Color>
+	using described_rook = swo3::described<Color, Color == color::white ? 'R' : 'r', swo3::rider(0, 1)>;
+
+	template<color Color>
+	using described_queen = swo3::described<Color, Color == color::white ? 'Q' : 'q', swo3::rider(0, 1) | swo3::rider(1, 1)>;
+
+	template<color Color>
+	using described_pawn = swo3::described<Color, Color == color::white ? 'P' : 'p', swo3::descriptor<4>{{
+		{1, 0, 1, true, false},
+		{1, 0, 2, true, false, true},
+		{1, 1, 1, false, true},
+		{1, -1, 1, false, true},
+	}}>;
+
+	template<template<color> typename Described>
+	void compare_with_builtin(char glyph) {
+		for(const auto fen : {swo3::startpos_fen, std::string_view{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}, std::string_view{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"}}) {
+			const auto builtin{swo3::parse_fen(fen).board};
+			for(auto i{0}; i < 8; ++i)
+				for(auto j{0}; j < 8; ++j)
+					if(const auto & piece{builtin[{i, j}]}; piece && std::toupper(piece->glyph()) == glyph) {
+						auto described{builtin};
+						described[{i, j}] = piece->color() == color::white ? swo3::chesspiece{Described<color::white>{}} : swo3::chesspiece{Described<color::black>{}};
+						if(piece->moved()) described[{i, j}]->mark_as_moved();
+						for(auto k{0}; k < 8; ++k)
+							for(auto l{0}; l < 8; ++l) {
+								const swo3::move m{{i, j}, {k, l}};
+								INFO(fen << ' ' << to_string(m.from) << to_string(m.to));
+								REQUIRE(static_cast<bool>(piece->is_valid_move(builtin, m)) == static_cast<bool>(described[{i, j}]->is_valid_move(described, m)));
+							}
+					}
+		}
+	}
+}
+
+TEST_CASE("Describing standard pieces", "[descriptor]") {
+	compare_with_builtin<described_knight>('N');
+	compare_with_builtin<described_bishop>('B');
+	compare_with_builtin<described_rook>('R');
+	compare_with_builtin<described_queen>('Q');
+
+	const swo3::chesspiece knight{described_knight<color::white>{}}, bishop{described_bishop<color::black>{}}, rook{described_rook<color::white>{}};
+	REQUIRE(knight.minor());
+	REQUIRE(!knight.colorbound());
+	REQUIRE(bishop.minor());
+	REQUIRE(bishop.colorbound());
+	REQUIRE(!rook.minor());
+	REQUIRE(described_knight<color::white>::targets("A1") == ((std::uint64_t{1} << (5 * 8 + 1)) | (std::uint64_t{1} << (6 * 8 + 2)))); //B3 and C2
+}
+
+TEST_CASE("Describing pawn moves", "[descriptor]") {
+	swo3::chessboard b;
+	b["E2"] = described_pawn<color::white>{};
+	b["D3"] = swo3::pawn<color::black>{};
+	REQUIRE(b["E2"]->is_valid_move(b, {"E2", "E3"}));
+	REQUIRE(b["E2"]->is_valid_move(b, {"E2", "E4"}));
+	REQUIRE(b["E2"]->is_valid_move(b, {"E2", "D3"}));
+	REQUIRE(!b["E2"]->is_valid_move(b, {"E2", "F3"})); //nothing to capture
+	REQUIRE(!b["E2"]->is_valid_move(b, {"E2", "E1"})); //backwards
+	b["E2"]->mark_as_moved();
+	REQUIRE(!b["E2"]->is_valid_move(b, {"E2", "E4"}));
+
+	b["D7"] = described_pawn<color::black>{};
+	REQUIRE(b["D7"]->is_valid_move(b, {"D7", "D5"}));
+	REQUIRE(!b["D7"]->is_valid_move(b, {"D7", "D8"}));
+}
+
+TEST_CASE("Describing fairy pieces", "[descriptor]") {
+	using nightrider = swo3::described<color::white, 'Z', swo3::rider(1, 2)>;
+	using archbishop = swo3::described<color::white, 'A', swo3::rider(1, 1) | swo3::leaper(1, 2)>;
+	using commoner = swo3::described<color::black, 'c', swo3::leaper(0, 1) | swo3::leaper(1, 1)>;
+
+	swo3::chessboard b;
+	b["A1"] = nightrider{};
+	REQUIRE(b["A1"]->is_valid_move(b, {"A1", "B3"}));
+	REQUIRE(b["A1"]->is_valid_move(b, {"A1", "D7"}));
+	b["C5"] = commoner{};
+	REQUIRE(!b["A1"]->is_valid_move(b, {"A1", "D7"})); //blocked
+	REQUIRE(b["A1"]->is_valid_move(b, {"A1", "C5"}));  //capture
+
+	b["E4"] = archbishop{};
+	REQUIRE(b["E4"]->is_valid_move(b, {"E4", "H7"}));
+	REQUIRE(b["E4"]->is_valid_move(b, {"E4", "F6"}));
+	REQUIRE(!b["E4"]->is_valid_move(b, {"E4", "E5"}));
+	REQUIRE(b["C5"]->is_valid_move(b, {"C5", "C4"}));
+	REQUIRE(!b["C5"]->is_valid_move(b, {"C5", "C3"}));
+}
@@ -0,0 +1,70 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <catch.hpp>
+#include <fen.hpp>
+#include <chesspieces.hpp>
+
+TEST_CASE("Parsing initial position", "[fen]") {
+	const auto fen{swo3::parse_fen(swo3::startpos_fen)};
+	const auto initial{swo3::initial_board()};
+	REQUIRE(fen.turn == swo3::color::white);
+	for(auto i{0}; i < 8; ++i)
+		for(auto j{0}; j < 8; ++j) {
+			const auto & actual{fen.board[{i, j}]}, & expected{initial[{i, j}]};
+			REQUIRE(actual.has_value() == expected.has_value());
+			if(actual) {
+				REQUIRE(actual->glyph() == expected->glyph());
+				REQUIRE(actual->color() == expected->color());
+				REQUIRE(!actual->moved());
+			}
+		}
+}
+
+TEST_CASE("Parsing castling rights", "[fen]") {
+	const auto fen{swo3::parse_fen("r3k2r/8/8/8/8/8/8/R3K2R b Kq - 0 1")};
+	REQUIRE(fen.turn == swo3::color::black);
+	REQUIRE(!fen.board["E1"]->moved());
+	REQUIRE(!fen.board["H1"]->moved());
+	REQUIRE(fen.board["A1"]->moved());
+	REQUIRE(!fen.board["E8"]->moved());
+	REQUIRE(fen.board["H8"]->moved());
+	REQUIRE(!fen.board["A8"]->moved());
+	REQUIRE(fen.board["E1"]->is_valid_move(fen.board, {"E1", "G1"}));
+	REQUIRE(!fen.board["E1"]->is_valid_move(fen.board, {"E1", "C1"}));
+}
+
+TEST_CASE("Rejecting invalid FEN", "[fen]") {
+	REQUIRE_THROWS_AS(swo3::parse_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1"), std::invalid_argument);
+	REQUIRE_THROWS_AS(swo3::parse_fen("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"), std::invalid_argument);
+	REQUIRE_THROWS_AS(swo3::parse_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNX w KQkq - 0 1"), std::invalid_argument);
+	REQUIRE_THROWS_AS(swo3::parse_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1"), std::invalid_argument);
+}
+
+TEST_CASE("Parsing halfmove clock", "[fen]") {
+	REQUIRE(swo3::parse_fen("8/8/8/3k4/8/8/8/Q3K3 w - - 42 80").board.halfmove_clock() == 42);
+	REQUIRE(swo3::parse_fen("8/8/8/3k4/8/8/8/Q3K3 w - -").board.halfmove_clock() == 0);
+	REQUIRE_THROWS_AS(swo3::parse_fen("8/8/8/3k4/8/8/8/Q3K3 w - - x 1"), std::invalid_argument);
+}
+
+TEST_CASE("Parsing en passant target square", "[fen]") {
+	auto black{swo3::parse_fen("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 3")};
+	REQUIRE(black.board.last_move() == swo3::move{"E2", "E4"});
+	REQUIRE(black.board.move({"D4", "E3"}) == swo3::state::ongoing);
+	REQUIRE(!black.board["E4"]);
+	REQUIRE(black.board["E3"]->glyph() == 'p');
+
+	auto white{swo3::parse_fen("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3")};
+	REQUIRE(white.board.last_move() == swo3::move{"F7", "F5"});
+	REQUIRE(!white.board["E5"]->is_valid_move(white.board, {"E5", "D6"})); //only the last push may be captured en passant
+	REQUIRE(white.board.move({"E5", "F6"}) == swo3::state::ongoing);
+	REQUIRE(!white.board["F5"]);
+
+	REQUIRE(!swo3::parse_fen(swo3::startpos_fen).board.last_move());
+	REQUIRE_THROWS_AS(swo3::parse_fen("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e6 0 3"), std::invalid_argument);
+	REQUIRE_THROWS_AS(swo3::parse_fen("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq d3 0 3"), std::invalid_argument);
+	REQUIRE_THROWS_AS(swo3::parse_fen("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e 0 3"), std::invalid_argument);
+}
@@ -0,0 +1,39 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <thread>
+#include <sstream>
+#include <catch.hpp>
+#include <chesspieces.hpp>
+#include <instrumentation.hpp>
+
+TEST_CASE("Counting hot path operations", "[instrumentation]") {
+	namespace instr = swo3::instrumentation;
+	instr::reset();
+	instr::start_tracing();
+	std::jthread{[] { //counters of finished threads must be retained
+		auto b{swo3::initial_board()};
+		b.move({"E2", "E4"});
+	}};
+	instr::stop_tracing();
+	const auto stats{instr::snapshot()};
+	std::ostringstream trace;
+	instr::write_trace(trace);
+
+	if constexpr(instr::enabled) {
+		REQUIRE(stats.dispatches['P'] > 0);
+		REQUIRE(stats.board_copies > 0);
+		REQUIRE(stats.in_check_tests > 0);
+		REQUIRE(stats.generator_frames > 0);
+		for(const auto & phase : stats.move_phases) REQUIRE(phase.calls == 1);
+		REQUIRE(trace.str().find("\"name\":\"adjudicate\"") != std::string::npos);
+	} else {
+		REQUIRE(stats.board_copies == 0);
+		REQUIRE(stats.move_phases[0].calls == 0);
+		REQUIRE(std::is_trivially_copyable_v<swo3::chessboard> == std::is_trivially_copyable_v<std::optional<swo3::chesspiece>>); //no hidden cost
+	}
+	REQUIRE(trace.str().starts_with("{\"traceEvents\":["));
+}
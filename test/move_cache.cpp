@@ -0,0 +1,75 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <random>
+#include <catch.hpp>
+#include <selfplay.hpp>
+#include <move_cache.hpp>
+#include <chesspieces.hpp>
+
+TEST_CASE("Hashing chessboards", "[move_cache]") {
+	const auto initial{swo3::initial_board()};
+	REQUIRE(initial.hash() == swo3::initial_board().hash());
+
+	auto moved{initial};
+	moved["E1"]->mark_as_moved();
+	REQUIRE(moved.hash() != initial.hash());
+
+	auto other{initial};
+	other["B1"] = swo3::bishop<swo3::color::white>{};
+	REQUIRE(other.hash() != initial.hash());
+
+	auto a{initial}, b{initial};
+	a.move({"E2", "E4"});
+	b.move({"E2", "E3"});
+	b.move({"E3", "E4"});
+	REQUIRE(a.hash() != b.hash()); //same pieces and moved-state, but last move differs (en passant)
+}
+
+TEST_CASE("Caching valid moves", "[move_cache]") {
+	swo3::move_cache cache{1 << 20};
+	const auto board{swo3::initial_board()};
+
+	const auto knight{cache.valid_moves(board, "G1")};
+	REQUIRE(knight->size() == 2);
+	REQUIRE(cache.valid_moves(board, "G1") == knight); //hit returns the same entry
+	REQUIRE(cache.valid_moves(board, "E1")->empty());
+	REQUIRE(cache.find(board, "G1") == knight);
+	REQUIRE(!cache.find(board, "B1")); //lookup only, nothing is inserted
+
+	auto stats{cache.stats()};
+	REQUIRE(stats.hits == 2);
+	REQUIRE(stats.misses == 3);
+	REQUIRE(stats.entries == 2);
+	REQUIRE(stats.bytes > 0);
+
+	cache.budget(16 * 64); //far too small for a single entry per shard
+	stats = cache.stats();
+	REQUIRE(stats.entries == 0);
+	REQUIRE(stats.evictions == 2);
+
+	cache.budget(0);
+	REQUIRE(!cache.enabled());
+	REQUIRE(cache.valid_moves(board, "B1")->size() == 2); //still computes
+	REQUIRE(cache.stats().entries == 0);
+}
+
+TEST_CASE("Playing with global move cache", "[move_cache]") {
+	const auto start{swo3::parse_fen(swo3::startpos_fen)};
+	const auto uncached{swo3::play(start, {.max_plies = 80}, std::mt19937_64{7})};
+
+	auto & cache{swo3::move_cache::global()};
+	cache.budget(16 << 20);
+	const auto cached{swo3::play(start, {.max_plies = 80}, std::mt19937_64{7})};
+	const auto replayed{swo3::play(start, {.max_plies = 80}, std::mt19937_64{7})};
+	const auto stats{cache.stats()};
+	cache.budget(0);
+
+	REQUIRE(cached.moves == uncached.moves);
+	REQUIRE(cached.result == uncached.result);
+	REQUIRE(replayed.moves == uncached.moves);
+	REQUIRE(stats.hits > 0); //moves of the replay are looked up in entries filled by move generation
+}
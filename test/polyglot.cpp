@@ -0,0 +1,77 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <random>
+#include <fstream>
+#include <catch.hpp>
+#include <polyglot.hpp>
+#include <chesspieces.hpp>
+
+namespace {
+	auto hash_after(std::initializer_list<swo3::move> moves) -> std::uint64_t {
+		auto b{swo3::initial_board()};
+		auto turn{swo3::color::white};
+		for(const auto & m : moves) {
+			b.move(m);
+			turn = ~turn;
+		}
+		return swo3::polyglot_hash(b, turn);
+	}
+}
+
+TEST_CASE("Polyglot hash reference values", "[polyglot]") { //taken from the Polyglot book format specification
+	REQUIRE(hash_after({}) == 0x463b96181691fc9c);
+	REQUIRE(hash_after({{"E2", "E4"}}) == 0x823c9b50fd114196);
+	REQUIRE(hash_after({{"E2", "E4"}, {"D7", "D5"}}) == 0x0756b94461c50fb0);
+	REQUIRE(hash_after({{"E2", "E4"}, {"D7", "D5"}, {"E4", "E5"}}) == 0x662fafb965db29d4);
+	REQUIRE(hash_after({{"E2", "E4"}, {"D7", "D5"}, {"E4", "E5"}, {"F7", "F5"}}) == 0x22a48b5a8e47ff78);
+	REQUIRE(hash_after({{"E2", "E4"}, {"D7", "D5"}, {"E4", "E5"}, {"F7", "F5"}, {"E1", "E2"}}) == 0x652a607ca3f242c1);
+	REQUIRE(hash_after({{"E2", "E4"}, {"D7", "D5"}, {"E4", "E5"}, {"F7", "F5"}, {"E1", "E2"}, {"E8", "F7"}}) == 0x00fdd303c946bdd9);
+	REQUIRE(hash_after({{"A2", "A4"}, {"B7", "B5"}, {"H2", "H4"}, {"B5", "B4"}, {"C2", "C4"}}) == 0x3c8123ea7b067637);
+	REQUIRE(hash_after({{"A2", "A4"}, {"B7", "B5"}, {"H2", "H4"}, {"B5", "B4"}, {"C2", "C4"}, {"B4", "C3"}, {"A1", "A3"}}) == 0x5c3f9b829b279560);
+}
+
+TEST_CASE("Looking up book moves", "[polyglot]") {
+	const auto path{std::filesystem::temp_directory_path() / "techess-test-book.bin"};
+	{
+		const auto initial{swo3::polyglot_hash(swo3::initial_board(), swo3::color::white)};
+		const auto after_e4{hash_after({{"E2", "E4"}})};
+		const auto write{[&](std::ostream & os, std::uint64_t value, int bytes) {
+			for(auto i{bytes - 1}; i >= 0; --i) os.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+		}};
+		std::ofstream os{path, std::ios::binary};
+		for(const auto & [key, move, weight] : std::initializer_list<std::tuple<std::uint64_t, std::uint16_t, std::uint16_t>>{
+			{initial - 1, 0x0000, 1},
+			{initial, 0x031C, 0}, //e2e4
+			{initial, 0x0292, 5}, //c2c3
+			{initial, 0x0000, 9}, //a1a1, invalid
+			{initial + 1, 0x0000, 1},
+			{after_e4, 0x0D24, 0}, //e7e5, must not be played
+		}) {
+			write(os, key, 8);
+			write(os, move, 2);
+			write(os, weight, 2);
+			write(os, 0, 4);
+		}
+	}
+
+	{
+		const swo3::opening_book book{path};
+		const auto entries{book.lookup(swo3::initial_board(), swo3::color::white)};
+		REQUIRE(entries.size() == 2);
+		REQUIRE(entries[0].move == swo3::move{"E2", "E4"});
+		REQUIRE(entries[1].move == swo3::move{"C2", "C3"});
+		REQUIRE(book.pick(swo3::initial_board(), swo3::color::white, std::mt19937{}) == swo3::move{"C2", "C3"}); //only move with non-zero weight
+		REQUIRE(book.lookup(swo3::initial_board(), swo3::color::black).empty());
+		REQUIRE(!book.pick(swo3::initial_board(), swo3::color::black, std::mt19937{}));
+
+		auto board{swo3::initial_board()};
+		board.move({"E2", "E4"});
+		REQUIRE(book.lookup(board, swo3::color::black).size() == 1);
+		REQUIRE(!book.pick(board, swo3::color::black, std::mt19937{})); //all moves have weight 0
+	}
+	std::filesystem::remove(path);
+}
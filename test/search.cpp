@@ -0,0 +1,39 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <catch.hpp>
+#include <fen.hpp>
+#include <search.hpp>
+#include <chesspieces.hpp>
+
+TEST_CASE("Enumerating legal moves", "[search]") {
+	const auto b{swo3::initial_board()};
+	REQUIRE(swo3::legal_moves(b, swo3::color::white).size() == 20);
+	REQUIRE(swo3::legal_moves(b, swo3::color::black).size() == 20);
+}
+
+TEST_CASE("Evaluating material", "[search]") {
+	const auto fen{swo3::parse_fen("4k3/8/8/8/8/8/8/R3K3 w - - 0 1")};
+	REQUIRE(swo3::evaluate(fen.board, swo3::color::white) == 500);
+	REQUIRE(swo3::evaluate(fen.board, swo3::color::black) == -500);
+}
+
+TEST_CASE("Finding mate in one", "[search]") {
+	const auto fen{swo3::parse_fen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1")};
+	int score{0};
+	const auto best{swo3::search(fen.board, fen.turn, {.depth = 2}, {}, [&](const swo3::search_info & info) { score = info.score; })};
+	REQUIRE(best);
+	REQUIRE(*best == swo3::move{"A1", "A8"});
+	REQUIRE(score == swo3::mate_score - 1);
+}
+
+TEST_CASE("Stopping search", "[search]") {
+	std::stop_source source;
+	source.request_stop();
+	const auto b{swo3::initial_board()};
+	REQUIRE(swo3::search(b, swo3::color::white, {}, source.get_token())); //falls back to first legal move
+	REQUIRE(!swo3::search(swo3::chessboard{}, swo3::color::white, {}));
+}
@@ -0,0 +1,62 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <random>
+#include <sstream>
+#include <catch.hpp>
+#include <selfplay.hpp>
+
+TEST_CASE("Playing random games", "[selfplay]") {
+	std::mt19937_64 gen{42};
+	const auto start{swo3::parse_fen(swo3::startpos_fen)};
+	for(auto i{0}; i < 3; ++i) {
+		const auto game{swo3::play(start, {.max_plies = 60}, gen)};
+		REQUIRE(!game.moves.empty());
+		REQUIRE(game.moves.size() <= 60);
+		if(game.result == swo3::outcome::unfinished) REQUIRE(game.moves.size() == 60);
+
+		auto board{start.board}; //moves must be replayable
+		for(const auto & m : game.moves) board.move(m);
+	}
+
+	const auto mated{swo3::play(swo3::parse_fen("6k1/5ppp/8/8/8/8/5PPP/3Q2K1 w - - 0 1"), {.depth = 2, .random_plies = 0}, gen)};
+	REQUIRE(mated.result == swo3::outcome::white_wins);
+	REQUIRE(mated.moves == std::vector<swo3::move>{{"D1", "D8"}});
+}
+
+TEST_CASE("Serializing game records", "[selfplay]") {
+	const std::vector<swo3::game_record> games{
+		{0, 0, swo3::outcome::draw, {}},
+		{1, 3, swo3::outcome::black_wins, {{"F2", "F3"}, {"E7", "E5"}, {"G2", "G4"}, {"D8", "H4"}}},
+		{70000, 65535, swo3::outcome::unfinished, {{"A1", "H8"}}},
+	};
+
+	std::stringstream ss;
+	{
+		swo3::game_writer writer{ss};
+		for(const auto & g : games) writer.write(g);
+	}
+	REQUIRE(ss.str().size() == 5 + 3 * 9 + 5 * 2);
+
+	swo3::game_reader reader{ss};
+	for(const auto & expected : games) {
+		const auto actual{reader.next()};
+		REQUIRE(actual);
+		REQUIRE(actual->id == expected.id);
+		REQUIRE(actual->start == expected.start);
+		REQUIRE(actual->result == expected.result);
+		REQUIRE(actual->moves == expected.moves);
+	}
+	REQUIRE(!reader.next());
+
+	std::stringstream truncated{ss.str().substr(0, 20)};
+	swo3::game_reader truncated_reader{truncated};
+	REQUIRE(truncated_reader.next());
+	REQUIRE_THROWS_AS(truncated_reader.next(), std::invalid_argument);
+
+	std::stringstream garbage{"nonsense"};
+	REQUIRE_THROWS_AS(swo3::game_reader{garbage}, std::invalid_argument);
+}
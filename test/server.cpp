@@ -0,0 +1,129 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <map>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sstream>
+#include <catch.hpp>
+#include <server.hpp>
+
+TEST_CASE("Strands keep the order of posted tasks", "[server]") {
+	constexpr auto strands{8}, posters{4}, tasks{500};
+	std::vector<std::shared_ptr<swo3::scheduler::strand>> s;
+	for(auto i{0}; i < strands; ++i) s.push_back(std::make_shared<swo3::scheduler::strand>());
+	std::vector<std::vector<std::pair<int, int>>> executed(strands); //(poster, sequence) per strand, only modified by tasks of that strand
+
+	{
+		swo3::scheduler scheduler{4};
+		std::vector<std::jthread> threads;
+		for(auto p{0}; p < posters; ++p)
+			threads.emplace_back([&, p] {
+				for(auto t{0}; t < tasks; ++t)
+					for(auto i{0}; i < strands; ++i)
+						scheduler.post(s[i], [&executed, i, p, t] { executed[i].emplace_back(p, t); });
+			});
+	}
+
+	for(const auto & e : executed) {
+		REQUIRE(e.size() == posters * tasks);
+		std::vector<int> last(posters, -1);
+		for(const auto & [p, t] : e) {
+			REQUIRE(t == last[p] + 1); //tasks of the same poster keep their order
+			last[p] = t;
+		}
+	}
+}
+
+TEST_CASE("Tasks of a strand never run concurrently", "[server]") {
+	constexpr auto strands{4}, tasks{200};
+	struct counted final {
+		std::shared_ptr<swo3::scheduler::strand> strand{std::make_shared<swo3::scheduler::strand>()};
+		std::atomic<int> active{0}, max_active{0};
+	};
+	std::vector<counted> s(strands);
+	std::atomic<int> total_max{0};
+
+	{
+		swo3::scheduler scheduler{4};
+		for(auto t{0}; t < tasks; ++t)
+			for(auto & c : s)
+				scheduler.post(c.strand, [&c, &total_max] {
+					const auto now{++c.active};
+					c.max_active = std::max(c.max_active.load(), now);
+					total_max = std::max(total_max.load(), now);
+					std::this_thread::yield();
+					--c.active;
+				});
+	}
+
+	for(const auto & c : s) REQUIRE(c.max_active == 1);
+	REQUIRE(total_max == 1);
+}
+
+TEST_CASE("Destroying a scheduler drains pending tasks", "[server]") {
+	std::atomic<int> executed{0};
+	{
+		swo3::scheduler scheduler{2};
+		const auto strand{std::make_shared<swo3::scheduler::strand>()};
+		for(auto i{0}; i < 1000; ++i)
+			scheduler.post(strand, [&] {
+				if(executed == 0) std::this_thread::sleep_for(std::chrono::milliseconds{10}); //ensure the queue is still filled when destruction starts
+				++executed;
+			});
+		for(auto i{0}; i < 1000; ++i) scheduler.post(std::make_shared<swo3::scheduler::strand>(), [&] { ++executed; });
+	}
+	REQUIRE(executed == 2000);
+}
+
+TEST_CASE("Serving games", "[server]") {
+	std::istringstream in{
+		"new g1\n"
+		"new g2\n"
+		"new g1\n"
+		"move g2 e7e5\n"
+		"move g1 e2e4\n"
+		"move g2 f2f3\n"
+		"move g1 e7e5\n"
+		"move g2 e7e5\n"
+		"move g1 e1e3\n"
+		"move g1 d7d5\n"
+		"move g2 g2g4\n"
+		"move g2 d8h4\n"
+		"move g2 a2a3\n"
+		"move x e2e4\n"
+		"dance g1\n"
+		"close g1\n"
+		"move g1 d2d4\n"
+		"\n"
+		"quit\n"
+		"new g3\n"
+	};
+	std::ostringstream out;
+	REQUIRE(swo3::serve(in, out) == 0);
+
+	std::map<std::string, std::vector<std::string>> replies; //by game id
+	std::istringstream lines{out.str()};
+	for(std::string line; std::getline(lines, line);) {
+		const auto space{line.find(' ')};
+		REQUIRE(space != std::string::npos);
+		replies[line.substr(0, space)].push_back(line.substr(space + 1));
+	}
+
+	REQUIRE(replies.size() == 3);
+	const auto split{[](const std::vector<std::string> & all) { //replies of the reading thread may overtake those of pending moves
+		std::pair<std::vector<std::string>, std::vector<std::string>> result; //(immediate, processed by scheduler)
+		for(const auto & line : all) (line == "created" || line.starts_with("error unknown") || line.starts_with("error game already") ? result.first : result.second).push_back(line);
+		return result;
+	}};
+	REQUIRE(split(replies["g1"]).first == std::vector<std::string>{"created", "error game already exists", "error unknown command", "error unknown game"});
+	REQUIRE(split(replies["g1"]).second == std::vector<std::string>{"ok", "ok", "error move from E1 to E3 is invalid", "error piece at D7 does not belong to the side to move", "closed"});
+	REQUIRE(replies["g2"] == std::vector<std::string>{"created", "error piece at E7 does not belong to the side to move", "ok", "ok", "ok", "checkmate", "error game is over"});
+	REQUIRE(replies["x"] == std::vector<std::string>{"error unknown game"});
+}
@@ -0,0 +1,111 @@
+
+//          Copyright Michael Florian Hava.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file ../LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <catch.hpp>
+#include <fen.hpp>
+#include <tablebase.hpp>
+#include <chesspieces.hpp>
+
+TEST_CASE("Naming tablebases", "[tablebase]") {
+	REQUIRE(swo3::tablebase_name(swo3::parse_fen("8/8/8/3k4/8/8/8/Q3K3 w - - 0 1").board) == "KQvK");
+	REQUIRE(swo3::tablebase_name(swo3::parse_fen("8/8/8/3k4/8/8/8/4K3 w - - 0 1").board) == "KvK");
+}
+
+TEST_CASE("Generating and probing KQvK", "[tablebase]") {
+	const auto directory{std::filesystem::temp_directory_path() / "techess-test-tablebase"};
+	std::filesystem::create_directories(directory);
+	const swo3::chesspiece material[]{swo3::king<swo3::color::white>{}, swo3::queen<swo3::color::white>{}, swo3::king<swo3::color::black>{}};
+	std::vector<std::string> generated;
+	swo3::generate_tablebases(material, directory, 2, [&](std::string_view name) { generated.emplace_back(name); });
+	REQUIRE(generated == std::vector<std::string>{"KvK", "KQvK"});
+
+	{
+		const swo3::tablebase tb{directory / "KQvK.tetb"};
+		const auto probe{[&](std::string_view fen) {
+			const auto position{swo3::parse_fen(fen)};
+			return tb.probe(position.board, position.turn);
+		}};
+
+		const auto mated{probe("3k4/3Q4/3K4/8/8/8/8/8 b - - 0 1")};
+		REQUIRE(mated);
+		REQUIRE(mated->result == swo3::wdl::loss);
+		REQUIRE(mated->plies == 0);
+
+		const auto mate_in_one{probe("3k4/8/3K4/8/8/8/8/7Q w - - 0 1")};
+		REQUIRE(mate_in_one);
+		REQUIRE(mate_in_one->result == swo3::wdl::win);
+		REQUIRE(mate_in_one->plies == 1);
+
+		const auto stalemate{probe("k7/2Q5/1K6/8/8/8/8/8 b - - 0 1")};
+		REQUIRE(stalemate);
+		REQUIRE(stalemate->result == swo3::wdl::draw);
+
+		const auto capture{probe("8/8/8/8/8/8/1k6/Q2K4 b - - 0 1")}; //queen is lost, KvK
+		REQUIRE(capture);
+		REQUIRE(capture->result == swo3::wdl::draw);
+
+		const auto centralized{probe("8/8/8/3k4/8/8/8/Q3K3 w - - 0 1")};
+		REQUIRE(centralized);
+		REQUIRE(centralized->result == swo3::wdl::win);
+		REQUIRE(centralized->plies == 15);
+
+		for(const auto & fen : {"8/8/8/4k3/8/8/8/3K3Q w - - 0 1", "Q3K3/8/8/8/3k4/8/8/8 w - - 0 1", "8/8/8/K7/4k3/8/8/Q7 w - - 0 1", "3K3Q/8/8/8/4k3/8/8/8 w - - 0 1"}) { //mirrored files, ranks, diagonal and rotated
+			const auto symmetric{probe(fen)};
+			REQUIRE(symmetric);
+			REQUIRE(symmetric->result == swo3::wdl::win);
+			REQUIRE(symmetric->plies == 15);
+		}
+
+		auto longest{0}; //of all positions with white to move, KQvK takes at most 10 moves to mate
+		for(auto i{0}; i < 64; ++i)
+			for(auto j{0}; j < 64; ++j)
+				for(auto k{0}; k < 64; ++k)
+					if(i != j && j != k && i != k) {
+						swo3::chessboard board;
+						board[{i / 8, i % 8}] = swo3::king<swo3::color::white>{};
+						board[{j / 8, j % 8}] = swo3::queen<swo3::color::white>{};
+						board[{k / 8, k % 8}] = swo3::king<swo3::color::black>{};
+						if(const auto entry{tb.probe(board, swo3::color::white)}; entry && entry->result == swo3::wdl::win) longest = std::max(longest, entry->plies);
+					}
+		REQUIRE(longest == 19);
+
+		REQUIRE(!probe("8/8/8/8/8/8/1k6/Q1K5 b - - 0 1")); //illegal: adjacent kings
+		REQUIRE(!probe("3k4/3Q4/3K4/8/8/8/8/8 w - - 0 1")); //illegal: side not to move is in check
+		REQUIRE(!probe("8/8/8/3k4/8/8/8/R3K3 w - - 0 1")); //different material
+	}
+	REQUIRE(std::filesystem::file_size(directory / "KQvK.tetb") == 16 + 10 * 63 * 62 * 2 * 2); //8-fold symmetry, no overlapping pieces
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Generating and probing KPvK", "[tablebase]") {
+	const auto directory{std::filesystem::temp_directory_path() / "techess-test-tablebase-pawn"};
+	std::filesystem::create_directories(directory);
+	const swo3::chesspiece material[]{swo3::king<swo3::color::white>{}, swo3::pawn<swo3::color::white>{}, swo3::king<swo3::color::black>{}};
+	swo3::generate_tablebases(material, directory, 2);
+
+	{
+		const swo3::tablebase tb{directory / "KPvK.tetb"};
+		const auto probe{[&](std::string_view fen) {
+			const auto position{swo3::parse_fen(fen)};
+			return tb.probe(position.board, position.turn);
+		}};
+
+		const auto win{probe("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1")};
+		REQUIRE(win);
+		REQUIRE(win->result == swo3::wdl::win);
+
+		const auto mirrored{probe("3k4/8/3K4/3P4/8/8/8/8 w - - 0 1")}; //only files may be mirrored with pawns on board
+		REQUIRE(mirrored);
+		REQUIRE(mirrored->result == swo3::wdl::win);
+		REQUIRE(mirrored->plies == win->plies);
+
+		const auto rook_pawn{probe("k7/8/K7/P7/8/8/8/8 w - - 0 1")};
+		REQUIRE(rook_pawn);
+		REQUIRE(rook_pawn->result == swo3::wdl::draw);
+	}
+	REQUIRE(std::filesystem::file_size(directory / "KPvK.tetb") == 16 + 32 * 63 * 62 * 2 * 2); //2-fold symmetry, no overlapping pieces
+	std::filesystem::remove_all(directory);
+}